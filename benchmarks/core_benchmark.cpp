@@ -0,0 +1,206 @@
+//
+// Created on 10/19/2026.
+//
+// Measures the engine's core data structures and math in isolation: chunk lookups, block queries, frustum tests,
+// transform rebuilds, block file parsing and noise sampling. Nothing here needs a window or an OpenGL context.
+// Usage: core-benchmark [output.json] (run from the build folder, next to resources/ or resources.pack)
+//
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include <glm/ext.hpp>
+#include "../libs/easylogging++.h"
+#include "../libs/FastNoise.h"
+#include "../include/block_registry.h"
+#include "../include/resource_pack.h"
+#include "../include/chunks.h"
+#include "../include/frustum.h"
+#include "../include/transform.h"
+
+INITIALIZE_EASYLOGGINGPP
+
+static constexpr int WORLD_SEED = 1234;
+static constexpr unsigned int QUERY_COUNT = 4096;
+static constexpr unsigned int REPETITIONS = 5;
+
+/// Written to by every test so the compiler can't drop the work being measured
+static volatile double sink = 0.0;
+
+/// The result of a single benchmark
+struct BenchmarkResult {
+    std::string name;
+    unsigned int iterations;
+    double bestNsPerOp;
+    double medianNsPerOp;
+};
+
+/** Runs a test a fixed number of times after a warmup, and keeps the best and the median of the repetitions
+ *
+ * @param name the benchmark's name, as written in the report
+ * @param iterations number of calls to the test per repetition
+ * @param test called with the iteration's index
+ */
+template<typename F>
+static BenchmarkResult run(const std::string &name, unsigned int iterations, F test) {
+    for (unsigned int i = 0; i < std::max(1u, iterations / 10); i++) {
+        test(i);
+    }
+
+    std::vector<double> samples;
+    for (unsigned int repetition = 0; repetition < REPETITIONS; repetition++) {
+        auto start = std::chrono::steady_clock::now();
+        for (unsigned int i = 0; i < iterations; i++) {
+            test(i);
+        }
+        auto end = std::chrono::steady_clock::now();
+        samples.push_back(std::chrono::duration<double, std::nano>(end - start).count() / iterations);
+    }
+    std::sort(samples.begin(), samples.end());
+
+    BenchmarkResult result{name, iterations, samples.front(), samples[samples.size() / 2]};
+    std::cout << std::setw(36) << std::left << name << std::right << " | " << std::setw(10) << iterations << " | "
+              << std::setw(14) << std::fixed << std::setprecision(1) << result.bestNsPerOp << " | "
+              << std::setw(14) << result.medianNsPerOp << std::endl;
+    return result;
+}
+
+/// Fills the world the same way as the engine's terrain generation, without the trees and letters
+static void fillWorld(ChunkManager &chunkManager, const WorldInfo &worldInfo, const FastNoise &noiseGen) {
+    for (unsigned int x = 0; x < worldInfo.getWidth(); x++) {
+        for (unsigned int z = 0; z < worldInfo.getLength(); z++) {
+            int height = static_cast<int>(std::round(((noiseGen.GetNoise(x, 0, z) + 1) * 10) + 1)) + 10;
+            auto chunk = *chunkManager.getChunkByXZ({x, z});
+            chunk->addEntity(Entity(ModelType::CUBE, BlockID::DIRT_GRASS,
+                                    Transform({x, height, z}, {1, 1, 1}, {0, 0, 0})));
+            for (int i = height - 1; i >= 0; i--) {
+                BlockID id = i >= 8 ? BlockID::DIRT : (i > 0 ? BlockID::STONE : BlockID::BEDROCK);
+                chunk->addEntity(Entity(ModelType::CUBE, id, Transform({x, i, z}, {1, 1, 1}, {0, 0, 0})));
+            }
+        }
+    }
+}
+
+/// Writes the results as JSON
+static bool writeReport(const std::string &path, const std::vector<BenchmarkResult> &results, size_t entityCount) {
+    std::ofstream file(path);
+    if (!file.is_open())
+        return false;
+
+    file << std::fixed << std::setprecision(2);
+    file << "{\n";
+    file << "  \"build\": \"" << __DATE__ << " " << __TIME__ << "\",\n";
+    file << "  \"seed\": " << WORLD_SEED << ",\n";
+    file << "  \"entities\": " << entityCount << ",\n";
+    file << "  \"repetitions\": " << REPETITIONS << ",\n";
+    file << "  \"benchmarks\": [";
+    for (size_t i = 0; i < results.size(); i++) {
+        file << (i == 0 ? "\n" : ",\n");
+        file << "    {\"name\": \"" << results[i].name << "\", \"iterations\": " << results[i].iterations
+             << ", \"bestNsPerOp\": " << results[i].bestNsPerOp
+             << ", \"medianNsPerOp\": " << results[i].medianNsPerOp << "}";
+    }
+    file << "\n  ]\n}\n";
+    return true;
+}
+
+int main(int argc, char *argv[]) {
+
+    el::Loggers::reconfigureAllLoggers(el::ConfigurationType::Enabled, "false");
+    std::string reportPath = argc > 1 ? argv[1] : "core_benchmark.json";
+
+    // the chunk code looks the blocks up in the registry
+    bool hasResources = ResourcePack::init(argv[0]);
+    if (hasResources || BlockRegistry::isCompiled())
+        BlockRegistry::init();
+
+    Config config{};
+    config.seed = WORLD_SEED;
+    config.worldSize = EngineConstants::SMALL_WORLD;
+    WorldInfo worldInfo(config);
+
+    FastNoise noiseGen(worldInfo.getSeed());
+    noiseGen.SetNoiseType(FastNoise::Simplex);
+
+    ChunkManager chunkManager(worldInfo);
+    fillWorld(chunkManager, worldInfo, noiseGen);
+
+    // the same query points for every run, inside the world and around the terrain's surface
+    std::mt19937 random(WORLD_SEED);
+    std::uniform_real_distribution<float> xDistribution(0.0f, static_cast<float>(worldInfo.getWidth() - 1));
+    std::uniform_real_distribution<float> yDistribution(5.0f, 25.0f);
+    std::uniform_real_distribution<float> zDistribution(0.0f, static_cast<float>(worldInfo.getLength() - 1));
+    std::vector<glm::vec3> queries(QUERY_COUNT);
+    std::vector<std::shared_ptr<Chunk>> queryChunks(QUERY_COUNT);
+    for (unsigned int i = 0; i < QUERY_COUNT; i++) {
+        queries[i] = {xDistribution(random), yDistribution(random), zDistribution(random)};
+        queryChunks[i] = *chunkManager.getChunkByXZ({queries[i].x, queries[i].z});
+    }
+
+    glm::vec3 center(worldInfo.getWidth() / 2.0f, 20.0f, worldInfo.getLength() / 2.0f);
+    ViewFrustum frustum;
+    frustum.update(glm::perspective(glm::radians(45.0f), 4.0f / 3.0f, EngineConstants::NEAR_PLANE,
+                                    EngineConstants::FAR_PLANE),
+                   glm::lookAt(center, center + glm::vec3(1.0f, -0.3f, 0.2f), glm::vec3(0.0f, 1.0f, 0.0f)));
+
+
+    std::cout << std::setw(36) << std::left << "benchmark" << std::right << " | iterations | best (ns/op) | "
+              << "median (ns/op)" << std::endl;
+
+    std::vector<BenchmarkResult> results;
+
+    results.push_back(run("ChunkManager::getChunkByXZ", 1u << 20u, [&](unsigned int i) {
+        const glm::vec3 &query = queries[i % QUERY_COUNT];
+        sink = sink + static_cast<double>(chunkManager.getChunkByXZ({query.x, query.z}).has_value());
+    }));
+
+    results.push_back(run("Chunk::getEntityByWorldPos", 1u << 12u, [&](unsigned int i) {
+        sink = sink + static_cast<double>(queryChunks[i % QUERY_COUNT]->getEntityByWorldPos(
+                queries[i % QUERY_COUNT]).has_value());
+    }));
+
+    results.push_back(run("Chunk::getEntityByBoxCollision", 1u << 12u, [&](unsigned int i) {
+        sink = sink + static_cast<double>(queryChunks[i % QUERY_COUNT]->getEntityByBoxCollision(
+                queries[i % QUERY_COUNT], BoundingBox({0.6f, 1.8f, 0.6f})).has_value());
+    }));
+
+    results.push_back(run("ViewFrustum::isBoxInFrustum", 1u << 22u, [&](unsigned int i) {
+        sink = sink + static_cast<double>(frustum.isBoxInFrustum(queries[i % QUERY_COUNT], BoundingBox({1, 1, 1})));
+    }));
+
+    Transform transform({0, 0, 0}, {1, 1, 1}, {0, 0, 0});
+    results.push_back(run("Transform::setPosition (rebuild)", 1u << 20u, [&](unsigned int i) {
+        transform.setPosition(queries[i % QUERY_COUNT]);
+        sink = sink + transform.getModelMatrix()[3][0];
+    }));
+
+    if (!hasResources && !BlockRegistry::isCompiled()) {
+        std::cout << "No resources, skipping BlockRegistry::init." << std::endl;
+    } else {
+        results.push_back(run("BlockRegistry::init", 1u << 8u, [&](unsigned int) {
+            BlockRegistry::init();
+            sink = sink + static_cast<double>(BlockRegistry::getDefinedBlocks().size());
+        }));
+    }
+
+    results.push_back(run("BlockRegistry::isOpaque", 1u << 22u, [&](unsigned int i) {
+        sink = sink + static_cast<double>(BlockRegistry::isOpaque(static_cast<BlockID>(i % BLOCK_ID_COUNT)));
+    }));
+
+    results.push_back(run("FastNoise::GetNoise (simplex)", 1u << 22u, [&](unsigned int i) {
+        sink = sink + noiseGen.GetNoise(static_cast<float>(i & 1023u), 0.0f, static_cast<float>(i >> 10u));
+    }));
+
+    if (!writeReport(reportPath, results, chunkManager.getNumberOfEntities())) {
+        std::cerr << "Could not write " << reportPath << "." << std::endl;
+        return 1;
+    }
+    std::cout << "Wrote " << reportPath << "." << std::endl;
+    return 0;
+}
@@ -0,0 +1,108 @@
+//
+// Created on 10/19/2026.
+//
+// Measures the throughput of the JobSystem and how it scales from 1 to N worker threads.
+// Usage: job-system-benchmark [max workers]
+//
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include "../libs/easylogging++.h"
+#include "../include/job_system.h"
+
+INITIALIZE_EASYLOGGINGPP
+
+static constexpr unsigned int SMALL_JOB_COUNT = 200000;
+static constexpr unsigned int HEAVY_WORK_ITEMS = 1u << 22u;
+static constexpr unsigned int HEAVY_GRAIN_SIZE = 1u << 12u;
+static constexpr unsigned int CHAIN_LENGTH = 20000;
+static constexpr unsigned int REPETITIONS = 3;
+
+/// Some arithmetic the compiler can't remove
+static double spin(unsigned int iterations, unsigned int seed) {
+    double value = seed;
+    for (unsigned int i = 0; i < iterations; i++) {
+        value = std::sqrt(value + i) * 1.0001;
+    }
+    return value;
+}
+
+/// Runs a test a few times and returns the best time in milliseconds
+template<typename F>
+static double bestOf(F test) {
+    double best = 1e30;
+    for (unsigned int i = 0; i < REPETITIONS; i++) {
+        auto start = std::chrono::steady_clock::now();
+        test();
+        auto end = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration<double, std::milli>(end - start).count());
+    }
+    return best;
+}
+
+/// Many tiny independent jobs, submitted from the main thread: measures the scheduling overhead
+static double smallJobs(JobSystem &jobs) {
+    std::atomic<unsigned long long> sink{0};
+    return bestOf([&]() {
+        std::vector<JobHandle> handles;
+        handles.reserve(SMALL_JOB_COUNT);
+        for (unsigned int i = 0; i < SMALL_JOB_COUNT; i++) {
+            handles.push_back(jobs.submit([&sink, i]() { sink += i; }));
+        }
+        jobs.waitAll(handles);
+    });
+}
+
+/// A fixed amount of work split with parallelFor: measures scaling
+static double heavyWork(JobSystem &jobs) {
+    std::vector<double> results(HEAVY_WORK_ITEMS / HEAVY_GRAIN_SIZE);
+    return bestOf([&]() {
+        jobs.wait(jobs.parallelFor(0, HEAVY_WORK_ITEMS, HEAVY_GRAIN_SIZE, [&results](unsigned int first,
+                                                                                  unsigned int last) {
+            results[first / HEAVY_GRAIN_SIZE] = spin(last - first, first);
+        }));
+    });
+}
+
+/// A long chain of continuations: measures the latency of releasing dependent jobs
+static double dependencyChain(JobSystem &jobs) {
+    return bestOf([&]() {
+        JobHandle previous;
+        for (unsigned int i = 0; i < CHAIN_LENGTH; i++) {
+            previous = jobs.submit([]() {}, {previous});
+        }
+        jobs.wait(previous);
+    });
+}
+
+int main(int argc, char *argv[]) {
+
+    el::Loggers::reconfigureAllLoggers(el::ConfigurationType::Enabled, "false");
+
+    unsigned int maxWorkers = std::max(1u, std::thread::hardware_concurrency());
+    if (argc > 1)
+        maxWorkers = static_cast<unsigned int>(std::stoi(argv[1]));
+
+    std::cout << "workers | small jobs (Mjobs/s) | heavy work (ms) | speedup | chain (us/job) | stolen" << std::endl;
+
+    double baseline = 0.0;
+    for (unsigned int workers = 1; workers <= maxWorkers; workers++) {
+        JobSystem jobs(workers);
+
+        double smallMs = smallJobs(jobs);
+        double heavyMs = heavyWork(jobs);
+        double chainMs = dependencyChain(jobs);
+        if (workers == 1)
+            baseline = heavyMs;
+
+        std::cout << std::setw(7) << workers << " | "
+                  << std::setw(20) << std::fixed << std::setprecision(2) << SMALL_JOB_COUNT / smallMs / 1000.0 << " | "
+                  << std::setw(15) << heavyMs << " | "
+                  << std::setw(7) << baseline / heavyMs << " | "
+                  << std::setw(14) << chainMs * 1000.0 / CHAIN_LENGTH << " | "
+                  << jobs.getStats().stolen << std::endl;
+    }
+    return 0;
+}
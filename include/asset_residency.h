@@ -0,0 +1,85 @@
+//
+// Created on 10/19/2026.
+//
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+/// Where a lazily loaded asset is in its life
+enum AssetState {
+    ASSET_UNLOADED,
+    ASSET_LOADING,
+    ASSET_RESIDENT,
+    ASSET_FAILED // its load failed, it isn't tried again
+};
+
+/// Counters of an AssetResidency since it was created
+struct AssetResidencyStats {
+    unsigned long long loads = 0;
+    unsigned long long evictions = 0;
+    unsigned int residentCount = 0;
+    int64_t residentBytes = 0;
+};
+
+/** Tracks which assets of a database are resident and when each was last used, so that they can be loaded on first use
+ * and the least recently used ones evicted once they take more than a budget.
+ *
+ * Assets are referred to by the index add() returned. The owner calls use() whenever it hands an asset out, loads it
+ * when use() asks for it, and calls nextFrame() once per frame to learn which assets to free. Only used from the main
+ * thread.
+ */
+class AssetResidency {
+public:
+    /// @param budget the bytes the resident assets may take before some are evicted, 0 for no limit
+    explicit AssetResidency(int64_t budget = 0) : budget(budget) {}
+
+    /** Registers an asset, unloaded
+     *
+     * @param pinned never evicted once loaded, i.e. a placeholder
+     * @return its index
+     */
+    size_t add(bool pinned = false);
+
+    /** Marks an asset as used during this frame
+     *
+     * @return true if it has to be loaded: it was unloaded and is now marked as loading, the owner must load it and
+     * then call loaded() or failed()
+     */
+    bool use(size_t index);
+
+    /// Marks a loading asset as resident, taking the given bytes of the budget
+    void loaded(size_t index, int64_t bytes);
+
+    /// Marks a loading asset as failed, so that it isn't requested again
+    void failed(size_t index);
+
+    /** Ends the frame and picks the assets to evict, the least recently used first, until the resident ones fit in the
+     * budget. Assets used during the frame that just ended and pinned ones are never picked. The picked assets are
+     * marked as unloaded, the owner must free them.
+     *
+     * @param canEvict if set, an asset is only picked when it returns true for its index
+     * @return the indices of the assets to free
+     */
+    std::vector<size_t> nextFrame(const std::function<bool(size_t)> &canEvict = nullptr);
+
+    [[nodiscard]] inline AssetState getState(size_t index) const { return slots[index].state; }
+
+    [[nodiscard]] inline size_t getCount() const { return slots.size(); }
+
+    [[nodiscard]] inline AssetResidencyStats getStats() const { return stats; }
+
+private:
+    struct Slot {
+        AssetState state = ASSET_UNLOADED;
+        bool pinned = false;
+        uint64_t lastUsedFrame = 0;
+        int64_t bytes = 0;
+    };
+
+    std::vector<Slot> slots;
+    int64_t budget;
+    uint64_t frame = 1; // starts at 1 so that 0 means never used
+    AssetResidencyStats stats{};
+};
@@ -0,0 +1,109 @@
+//
+// Created on 10/19/2026.
+//
+#pragma once
+
+#include <array>
+#include <deque>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "block.h"
+#include "texture.h"
+
+/// The faces of a cube map block, in the order of the cube map's layers
+enum BlockFace {
+    FACE_RIGHT,
+    FACE_LEFT,
+    FACE_TOP,
+    FACE_BOTTOM,
+    FACE_BACK,
+    FACE_FRONT,
+    BLOCK_FACE_COUNT
+};
+
+/** Everything a .block file defines about a type of block. Paths are resource paths, i.e. "textures/dirt.png".
+ *
+ * The members are in the order tools/generate_block_table.py writes them, keep both in sync.
+ */
+struct BlockProperties {
+    BlockID id = PLAYER;
+    bool defined = false;                                    // false for the IDs without a .block file
+    std::string_view name;
+    std::string_view model;
+    TextureType textureType = ABSTRACT;
+    std::string_view texture;                                // TEXTURE2D, every face
+    std::array<std::string_view, BLOCK_FACE_COUNT> faces{}; // CUBEMAP, one per BlockFace
+    std::string_view placeSound;                             // played when the player places it, empty for none
+    bool opaque = true;                                      // hides the faces of the blocks next to it
+    bool transparent = false;                                // blended, drawn in the translucent pass
+    bool breakable = true;
+    unsigned int slot = 0;                                   // the number key that selects it, 0 if none
+};
+
+/** Holds the properties of every block in a dense table indexed by BlockID. (singleton)
+ *
+ * The .block files are parsed once, by init; the rest of the engine only looks the table up. With the
+ * COMPILED_BLOCK_REGISTRY CMake option the table is generated from resources/blocks at build time and nothing is
+ * parsed at run time.
+ *
+ * A .block file has one "key: value" per line: name, ID, model, all (the texture of every face) or right, left, top,
+ * bottom, back and front (a cube map), sound, opaque, transparent, breakable and slot.
+ */
+class BlockRegistry {
+public:
+    /// Number of block selection keys
+    static constexpr unsigned int SLOT_COUNT = 9;
+
+    /// Loads the block definitions, from the .block files or the compiled table, after ResourcePack::init
+    static void init();
+
+    /// True when the table was compiled in rather than parsed
+    [[nodiscard]] static bool isCompiled();
+
+    [[nodiscard]] static inline const BlockProperties &get(BlockID id) { return instance.table[id]; }
+
+    [[nodiscard]] static inline bool isOpaque(BlockID id) { return instance.table[id].opaque; }
+
+    [[nodiscard]] static inline bool isTransparent(BlockID id) { return instance.table[id].transparent; }
+
+    /// The IDs that have a .block file, in increasing order
+    [[nodiscard]] static inline const std::vector<BlockID> &getDefinedBlocks() { return instance.definedBlocks; }
+
+    /** Returns the block selected by a number key
+     *
+     * @param slot the index of the key, 0 for key 1
+     * @return nothing if no block uses that key
+     */
+    [[nodiscard]] static inline std::optional<BlockID> getBlockInSlot(unsigned int slot) {
+        return slot < SLOT_COUNT ? instance.slots[slot] : std::nullopt;
+    }
+
+private:
+    BlockRegistry() = default;
+
+    BlockRegistry(const BlockRegistry &) = delete;
+
+    BlockRegistry &operator=(const BlockRegistry &) = delete;
+
+    static BlockRegistry instance;
+
+    std::array<BlockProperties, BLOCK_ID_COUNT> table{};
+    std::vector<BlockID> definedBlocks;
+    std::array<std::optional<BlockID>, SLOT_COUNT> slots{};
+    std::deque<std::string> strings; // the parsed values the table's views point to
+
+    /** Parses one .block file into the table
+     *
+     * @param fileName the name of the file, for the log
+     * @param text the content of the file
+     */
+    void parse(const std::string &fileName, std::string_view text);
+
+    /// Keeps a copy of a parsed value alive for the table
+    std::string_view intern(std::string value);
+
+    /// Adds a block to the table, false if its ID is out of range or already taken
+    bool add(const BlockProperties &block, const std::string &source);
+};
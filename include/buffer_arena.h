@@ -0,0 +1,129 @@
+//
+// Created on 10/19/2026.
+//
+#pragma once
+
+#include <GL/glew.h>
+#include <vector>
+#include <unordered_map>
+
+/// Memory usage of a BufferArena
+struct BufferArenaStats {
+    unsigned int pageCount = 0;
+    unsigned int allocationCount = 0;
+    GLsizeiptr capacity = 0;     // bytes reserved on the GPU, over all pages
+    GLsizeiptr bytesInUse = 0;   // bytes handed out
+    GLsizeiptr largestFreeRange = 0;
+
+    /// 0 when all the free space is in one range, close to 1 when it is scattered in many small ranges
+    [[nodiscard]] inline float fragmentation() const {
+        GLsizeiptr bytesFree = capacity - bytesInUse;
+        return bytesFree == 0 ? 0.0f : 1.0f - (float) largestFreeRange / (float) bytesFree;
+    }
+};
+
+/** A few large GL buffers (pages) that hand out ranges to many meshes.
+ *
+ * Ranges are referred to by handle rather than by offset, so the arena is free to move them around when it
+ * defragments. Free space is kept in a first-fit free list per page that coalesces neighbouring ranges. When no page
+ * has a big enough free range, a new page is added; pages are never reallocated, so their buffer IDs are stable and
+ * vertex arrays pointing at them stay valid. Vertices and indices may share an allocation: a page can be bound as both
+ * GL_ARRAY_BUFFER and GL_ELEMENT_ARRAY_BUFFER.
+ */
+class BufferArena {
+public:
+    typedef unsigned int Handle;
+    static constexpr Handle INVALID_HANDLE = 0;
+
+    /// @param pageSize the size in bytes of each page. Bigger allocations get a page of their own.
+    explicit BufferArena(GLsizeiptr pageSize);
+
+    ~BufferArena();
+
+    BufferArena(const BufferArena &) = delete;
+
+    BufferArena &operator=(const BufferArena &) = delete;
+
+    /** Reserves a range of one of the pages
+     *
+     * @param size the size in bytes
+     * @param alignment the offset of the range will be a multiple of this (i.e. the vertex stride)
+     * @return a handle to the range
+     */
+    Handle allocate(GLsizeiptr size, GLsizeiptr alignment);
+
+    /// Gives a range back to the arena. The handle becomes invalid.
+    void release(Handle handle);
+
+    /** Changes the size of a range without moving it. Shrinking always succeeds, growing only if the space right
+     * after the range is free.
+     *
+     * @param handle the range to resize
+     * @param size the new size in bytes
+     * @return true if the range now has the given size, false if it has to be reallocated
+     */
+    bool resize(Handle handle, GLsizeiptr size);
+
+    /** Writes data into a range
+     *
+     * @param handle the range to write to
+     * @param offset the offset in bytes inside the range
+     * @param data the data to copy
+     * @param size the size in bytes, offset + size must fit in the range
+     */
+    void write(Handle handle, GLintptr offset, const void *data, GLsizeiptr size);
+
+    /** Packs the ranges of every page towards its start so that the free space is in one piece. Handles stay valid,
+     * but their offsets change.
+     */
+    void defragment();
+
+    /// Returns the byte offset of a range inside its page
+    [[nodiscard]] GLintptr getOffset(Handle handle) const;
+
+    /// Returns the size in bytes of a range
+    [[nodiscard]] GLsizeiptr getSize(Handle handle) const;
+
+    /// Returns the index of the page holding a range
+    [[nodiscard]] unsigned int getPage(Handle handle) const;
+
+    /// Returns the GL buffer backing a page
+    [[nodiscard]] inline GLuint getBufferId(unsigned int page) const { return pages[page].bufferId; }
+
+    [[nodiscard]] inline unsigned int getPageCount() const { return static_cast<unsigned int>(pages.size()); }
+
+    [[nodiscard]] BufferArenaStats getStats() const;
+
+private:
+    struct Range {
+        GLintptr offset;
+        GLsizeiptr size;
+    };
+
+    struct Allocation {
+        unsigned int page;
+        Range range;
+        GLsizeiptr alignment;
+    };
+
+    struct Page {
+        GLuint bufferId;
+        GLsizeiptr capacity;
+        std::vector<Range> freeRanges; // sorted by offset
+    };
+
+    GLsizeiptr pageSize;
+    std::vector<Page> pages{};
+    std::unordered_map<Handle, Allocation> allocations{};
+    GLsizeiptr bytesInUse = 0;
+    Handle nextHandle = 1;
+
+    /// Tries to carve an aligned range out of a page's free list
+    bool allocateFromPage(unsigned int page, GLsizeiptr size, GLsizeiptr alignment, Range &out);
+
+    /// Returns a range to a page's free list, merging it with its neighbours
+    static void insertFreeRange(Page &page, Range range);
+
+    /// Creates a new page with at least the given capacity
+    void addPage(GLsizeiptr capacity);
+};
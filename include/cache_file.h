@@ -0,0 +1,55 @@
+//
+// Created on 10/19/2026.
+//
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <ostream>
+#include <string>
+#include "resource_pack.h"
+
+/** The parts the on-disk caches (TextureCache, MeshCache) share: how an entry is named after its source, how the
+ * version of the source is identified, and how an entry is written safely. (static)
+ */
+class CacheFile {
+public:
+    CacheFile() = delete;
+
+    /** The entry of a source resource, named after its file (each cache only holds resources of a single folder)
+     *
+     * @param cacheDir the folder of the cache
+     * @param sourcePath the resource the entry is made from
+     * @param extension appended to the name of the source, i.e. ".tex"
+     */
+    static std::filesystem::path getPath(const char *cacheDir, const std::string &sourcePath, const char *extension);
+
+    /** Fills the sourceSize and sourceTime fields of an entry's header from ResourcePack::describe, so that the entry
+     * can be told apart from one made from another version of the source
+     *
+     * @return false if the source can't be found
+     */
+    template<typename Header>
+    static bool describeSource(const std::string &sourcePath, Header &header) {
+        uint64_t size = 0;
+        int64_t time = 0;
+        if (!ResourcePack::describe(sourcePath, size, time))
+            return false;
+        header.sourceSize = size;
+        header.sourceTime = time;
+        return true;
+    }
+
+    /** Writes an entry next to where it goes, then renames it into place, so a crash never leaves half an entry
+     * behind. Each thread writes its own temporary file, so the same entry can be stored from several at once. Can be
+     * called from any thread.
+     *
+     * @param path the entry, see getPath; its folder is created if needed
+     * @param sourcePath the resource the entry is made from, for the warnings
+     * @param write writes the content of the entry to the stream it's given
+     * @return true if the entry was written
+     */
+    static bool write(const std::filesystem::path &path, const std::string &sourcePath,
+                      const std::function<void(std::ostream &)> &write);
+};
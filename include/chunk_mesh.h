@@ -0,0 +1,93 @@
+//
+// Created on 10/19/2026.
+//
+#pragma once
+
+#include <map>
+#include <memory>
+#include <vector>
+#include <glm/glm.hpp>
+#include "block.h"
+#include "entity.h"
+#include "mesh.h"
+#include "buffer_arena.h"
+#include "water_surface.h"
+
+/// A range of a chunk's indices that is drawn with a single texture
+struct ChunkSubMesh {
+    BlockID blockId;
+    unsigned int firstIndex;
+    unsigned int indexCount;
+};
+
+/// A chunk's geometry as baked on the CPU, ready to be uploaded
+struct ChunkMeshData {
+    std::vector<ChunkVertex> vertices{};
+    std::vector<unsigned int> indices{};
+    std::vector<ChunkSubMesh> subMeshes{}; // opaque geometry, one per block type
+    unsigned int waterFirstIndex = 0;
+    WaterSurface water{};
+    glm::vec3 boundsMin{0.0f};
+    glm::vec3 boundsMax{0.0f};
+};
+
+/** Bakes the blocks of a chunk into a single world space mesh.
+ *
+ * Faces shared by two full blocks are left out. Blocks that aren't full, grid aligned cubes keep all their faces and
+ * never hide the faces of their neighbours. Water is only baked as the surface exposed to air.
+ *
+ * @param entitiesByBlockID the blocks of the chunk, grouped by block type
+ * @return the baked mesh
+ */
+ChunkMeshData bakeChunkMesh(const std::map<BlockID, std::vector<std::shared_ptr<Entity>>> &entitiesByBlockID);
+
+/// The uploaded geometry of a chunk, living in a range of the shared chunk BufferArena.
+class ChunkMesh {
+private:
+    BufferArena::Handle allocation = BufferArena::INVALID_HANDLE;
+    unsigned int vertexCount = 0;
+    unsigned int indexCount = 0;
+    std::vector<ChunkSubMesh> subMeshes{};
+    unsigned int waterFirstIndex = 0;
+    WaterSurface water{};
+    std::vector<unsigned int> waterIndices{};
+    glm::vec3 boundsMin{0.0f};
+    glm::vec3 boundsMax{0.0f};
+
+public:
+    /// Replaces the current geometry with the given baked data, in place if it fits in the current range
+    void upload(BufferArena &arena, ChunkMeshData &&data);
+
+    /// Gives the geometry's range back to the arena
+    void release(BufferArena &arena);
+
+    /// Re-sorts the water faces back to front if the camera moved far enough, updating the indices in place
+    void sortWater(BufferArena &arena, const glm::vec3 &viewPos);
+
+    /// The index of the first vertex in its page, used as base vertex when drawing
+    [[nodiscard]] GLint getBaseVertex(const BufferArena &arena) const;
+
+    /// The arena page holding the geometry
+    [[nodiscard]] unsigned int getPage(const BufferArena &arena) const;
+
+    /// The index (in GLuint units) of the first index in its page
+    [[nodiscard]] GLuint getFirstIndex(const BufferArena &arena) const;
+
+    [[nodiscard]] inline const std::vector<ChunkSubMesh> &getSubMeshes() const { return subMeshes; }
+
+    [[nodiscard]] inline unsigned int getWaterFirstIndex() const { return waterFirstIndex; }
+
+    [[nodiscard]] inline unsigned int getWaterIndexCount() const { return water.getIndexCount(); }
+
+    [[nodiscard]] inline bool isEmpty() const { return indexCount == 0; }
+
+    /// Bytes kept on the CPU, the geometry itself only lives in the arena
+    [[nodiscard]] inline size_t getCpuBytes() const {
+        return subMeshes.capacity() * sizeof(ChunkSubMesh) + waterIndices.capacity() * sizeof(unsigned int) +
+               water.getCpuBytes();
+    }
+
+    [[nodiscard]] inline const glm::vec3 &getBoundsMin() const { return boundsMin; }
+
+    [[nodiscard]] inline const glm::vec3 &getBoundsMax() const { return boundsMax; }
+};
@@ -0,0 +1,142 @@
+//
+// Created on 10/19/2026.
+//
+#pragma once
+
+#include <GL/glew.h>
+#include <memory>
+#include <unordered_set>
+#include <vector>
+#include <glm/glm.hpp>
+#include "buffer_arena.h"
+#include "chunks.h"
+#include "drawable.h"
+#include "frustum.h"
+#include "job_system.h"
+#include "render_queue.h"
+
+/// Layout of a single indirect draw, as read by glMultiDrawElementsIndirect
+struct DrawElementsIndirectCommand {
+    GLuint count;
+    GLuint instanceCount;
+    GLuint firstIndex;
+    GLint baseVertex;
+    GLuint baseInstance;
+};
+
+class ChunkRenderer;
+
+/// A range of the frame's indirect commands that share a texture, a pass and an arena page, drawn as a single Drawable
+class ChunkBatch : public Drawable {
+private:
+    const ChunkRenderer *renderer;
+    GLuint vaoId;
+    unsigned int firstCommand;
+    unsigned int commandCount;
+
+public:
+    ChunkBatch(const ChunkRenderer *renderer, GLuint vaoId, unsigned int firstCommand, unsigned int commandCount);
+
+    void draw() const override;
+
+    [[nodiscard]] GLuint getVaoId() const override;
+};
+
+/** Draws the baked meshes of the visible chunks.
+ *
+ * All chunk geometry lives in one BufferArena, with one vertex array per arena page. Every frame, the visible sub
+ * meshes are turned into indirect draw commands and grouped by texture and page, so each block type costs a single
+ * multi-draw call per pass and page no matter how many chunks are visible. Without GL 4.3 / ARB_multi_draw_indirect,
+ * the commands of a batch are issued one by one with glDrawElementsBaseVertex instead.
+ *
+ * Meshes are baked by jobs on a snapshot of the chunk's blocks and uploaded by a continuation on the main thread, so a
+ * chunk keeps drawing its previous mesh until the new one is ready.
+ */
+class ChunkRenderer {
+private:
+    struct VisibleChunk {
+        const ChunkMesh *mesh;
+        unsigned int page;
+        float distance;
+    };
+
+    JobSystem &jobs;
+    BufferArena arena;
+    std::vector<GLuint> pageVaos{}; // one vertex array per arena page
+    GLuint indirectBufferId{};
+    bool multiDrawIndirect;
+    unsigned int uploadsSinceDefragment = 0;
+    std::unordered_set<const Chunk *> bakesInFlight{};
+
+    std::vector<VisibleChunk> visibleChunks{};
+    std::vector<DrawElementsIndirectCommand> commands{};
+    std::vector<std::unique_ptr<ChunkBatch>> batches{};
+
+    /// Creates the vertex arrays of the arena pages added since the last call
+    void createPageVaos();
+
+    /// Bakes a chunk's mesh in a job and uploads it from the main thread once done
+    JobHandle scheduleBake(Chunk &chunk);
+
+    /// Appends a command for a range of a chunk's indices
+    void addCommand(const ChunkMesh &mesh, unsigned int firstIndex, unsigned int indexCount);
+
+    /// Creates a batch for the commands added since firstCommand and submits it to the queue
+    void submitBatch(RenderQueue &queue, RenderPass pass, Shader &shader, BlockID blockId, unsigned int page,
+                     unsigned int firstCommand, float viewDepth, float opacity);
+
+public:
+    /// Size in bytes of each page of the chunk arena
+    static constexpr GLsizeiptr ARENA_PAGE_SIZE = 16 * 1024 * 1024;
+
+    /// Fragmentation of the arena's free space above which it is packed again
+    static constexpr float DEFRAGMENT_THRESHOLD = 0.5f;
+
+    /// @param jobs the job system the chunk meshes are baked on
+    explicit ChunkRenderer(JobSystem &jobs);
+
+    ~ChunkRenderer();
+
+    ChunkRenderer(const ChunkRenderer &) = delete;
+
+    ChunkRenderer &operator=(const ChunkRenderer &) = delete;
+
+    /// Forgets the chunks of the previous frame, and defragments the arena if chunks were rebuilt and it needs it
+    void beginFrame();
+
+    /** Bakes and uploads the meshes of the given chunks, using all the workers, and waits for them.
+     *
+     * @param chunks the chunks to rebuild
+     */
+    void rebuildChunks(const std::vector<std::shared_ptr<Chunk>> &chunks);
+
+    /** Adds a chunk to the frame if its mesh is in view. If the chunk changed, a new mesh is baked in the background.
+     *
+     * @param chunk the chunk to draw
+     * @param frustum the view frustum used to cull the chunk
+     * @param viewPos the camera position, used to sort the chunks and their water
+     */
+    void addChunk(Chunk &chunk, const ViewFrustum &frustum, const glm::vec3 &viewPos);
+
+    /** Builds the frame's draw commands and submits one batch per block type to the opaque pass, and the water to the
+     * translucent pass.
+     *
+     * @param queue the render queue of the current frame
+     * @param shader the shader to draw the chunks with
+     */
+    void submit(RenderQueue &queue, Shader &shader);
+
+    /// Gives a chunk's geometry back to the arena, i.e. when the chunk is unloaded
+    void releaseChunk(Chunk &chunk);
+
+    [[nodiscard]] inline bool usesMultiDrawIndirect() const { return multiDrawIndirect; }
+
+    [[nodiscard]] inline GLuint getIndirectBufferId() const { return indirectBufferId; }
+
+    [[nodiscard]] inline const std::vector<DrawElementsIndirectCommand> &getCommands() const { return commands; }
+
+    /// Number of chunks added since the last beginFrame that passed the frustum test
+    [[nodiscard]] inline size_t getVisibleChunkCount() const { return visibleChunks.size(); }
+
+    [[nodiscard]] inline BufferArenaStats getArenaStats() const { return arena.getStats(); }
+};
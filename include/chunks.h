@@ -4,7 +4,9 @@
 #pragma once
 
 #include <glm/glm.hpp>
+#include <cstdint>
 #include <memory>
+#include <string>
 #include <vector>
 #include <optional>
 #include <unordered_map>
@@ -12,6 +14,8 @@
 #include "block.h"
 #include "entity.h"
 #include "frustum.h"
+#include "chunk_mesh.h"
+#include "logging.h"
 
 /// Config for the application
 struct Config {
@@ -20,8 +24,25 @@ struct Config {
     int seed = EngineConstants::RANDOM_SEED;
     int worldSize = EngineConstants::SMALL_WORLD;
     float fov = 45.0f;
+    bool headless = false; // no visible window or input, flies a scripted camera path and writes a report
+    unsigned int frames = EngineConstants::DEFAULT_HEADLESS_FRAMES;
+    std::string reportPath = EngineConstants::HEADLESS_REPORT_PATH;
+    std::string recordPath; // records the session's input to this file, if set
+    std::string replayPath; // replays this input recording headlessly, on the world it was recorded in
+    unsigned int renderStatsInterval = 0; // logs the render counters every this many frames, 0 to never log them
+    std::string startupReportPath = EngineConstants::STARTUP_REPORT_PATH;
+    bool quantizeModels = false; // packs the models' vertices in 16 bytes instead of 32
+    bool lazyAssets = false; // loads textures, models and music on first use under a budget, see TextureDatabase
 };
 
+/// Mixes a value into a hash (splitmix64's finalizer), used for the world state hashes
+inline uint64_t hashCombine(uint64_t hash, uint64_t value) {
+    uint64_t mixed = hash ^ (value + 0x9e3779b97f4a7c15ull + (hash << 6u) + (hash >> 2u));
+    mixed = (mixed ^ (mixed >> 30u)) * 0xbf58476d1ce4e5b9ull;
+    mixed = (mixed ^ (mixed >> 27u)) * 0x94d049bb133111ebull;
+    return mixed ^ (mixed >> 31u);
+}
+
 /// Contains basic world info (size and seed)
 class WorldInfo {
 private:
@@ -53,6 +74,8 @@ private:
     std::map<EntityID, std::shared_ptr<Entity>> entities{};
     std::map<BlockID, std::vector<std::shared_ptr<Entity>>> entitiesByBlockID{};
     std::pair<unsigned int, unsigned int> origin; // X / CHUNK_WIDTH, Z / CHUNK_LENGTH
+    ChunkMesh mesh{};
+    bool meshDirty = true;
 
     /** Checks if the given XZ coordinates are outside this Chunk
      *
@@ -68,14 +91,15 @@ public:
     /// <br/><br/>In other words, this method gives ownership of the entity to the Chunk.
     inline void addEntity(Entity &&entity) {
         if (isBlockOutOfBounds({entity.getTransform().getPosition().x, entity.getTransform().getPosition().z})) {
-            LOG(DEBUG) << "Adding an entity to Chunk at " << origin.first * EngineConstants::CHUNK_WIDTH << " "
-                       << origin.second * EngineConstants::CHUNK_LENGTH << " that is out of bounds at "
-                       << entity.getTransform().getPosition().x << " " << entity.getTransform().getPosition().z;
+            ENGINE_LOG(DEBUG) << "Adding an entity to Chunk at " << origin.first * EngineConstants::CHUNK_WIDTH << " "
+                              << origin.second * EngineConstants::CHUNK_LENGTH << " that is out of bounds at "
+                              << entity.getTransform().getPosition().x << " " << entity.getTransform().getPosition().z;
         }
 
         std::shared_ptr<Entity> ent = std::make_shared<Entity>(std::move(entity));
         entities[ent->getEntityID()] = ent;
         entitiesByBlockID[ent->getBlockID()].push_back(ent);
+        meshDirty = true;
     }
 
     /// Returns a reference to this chunk's entities
@@ -83,11 +107,18 @@ public:
         return entities;
     }
 
-    /** Renders the entities in this Chunk
-     *
-     * @param shader the shader to use to draw the entities
-     */
-    void renderChunk(Shader &shader, const ViewFrustum &frustum);
+    /// Returns this chunk's entities, grouped by block type
+    [[nodiscard]] inline const std::map<BlockID, std::vector<std::shared_ptr<Entity>>> &getEntitiesByBlockID() const {
+        return entitiesByBlockID;
+    }
+
+    /// Returns the uploaded mesh of this Chunk
+    inline ChunkMesh &getMesh() { return mesh; }
+
+    /// Returns true if blocks were added or removed since the mesh was last baked
+    [[nodiscard]] inline bool isMeshDirty() const { return meshDirty; }
+
+    inline void setMeshDirty(bool dirty) { meshDirty = dirty; }
 
     /** Returns an entity in absolute world position
      *
@@ -157,5 +188,21 @@ public:
 
     [[nodiscard]] size_t getNumberOfEntities() const;
 
+    /** Hashes the type and position of every block in the world. The hash doesn't depend on the order the blocks were
+     * added in, nor on their entity IDs, so two worlds with the same blocks always hash the same.
+     *
+     * @return the hash of the world's blocks
+     */
+    [[nodiscard]] uint64_t computeHash() const;
+
+    /** Measures the memory held by the world's blocks and by the chunk meshes' CPU side, and stores it in MemoryStats
+     * (WORLD_ENTITIES, WORLD_INDICES and CHUNK_MESHES_CPU). The sizes of the map nodes and control blocks are
+     * estimated from the usual standard library layouts.
+     */
+    void measureMemory() const;
+
+    /// Returns all the chunks in the world
+    [[nodiscard]] std::vector<std::shared_ptr<Chunk>> getChunks() const;
+
     [[nodiscard]] inline size_t getNumberOfChunks() const { return this->chunks.size(); };
 };
\ No newline at end of file
@@ -0,0 +1,38 @@
+//
+// Created on 10/19/2026.
+//
+#pragma once
+
+#include <array>
+#include <glm/glm.hpp>
+
+/// One face of the unit cube. The corners are wound like resources/models/cube.obj (clockwise front faces).
+struct CubeFace {
+    glm::vec3 normal;
+    std::array<glm::vec3, 4> corners;
+    std::array<glm::vec2, 4> textureCoordinates;
+};
+
+/// Procedural unit cube used to build block geometry without going through the .obj loader
+namespace CubeGeometry {
+    enum Direction {
+        NEG_Z = 0,
+        POS_Z = 1,
+        NEG_X = 2,
+        POS_X = 3,
+        NEG_Y = 4,
+        POS_Y = 5
+    };
+
+    /// The two triangles of a face, as indices into its corners
+    static constexpr unsigned int FACE_INDICES[6] = {0, 1, 2, 2, 3, 0};
+
+    inline const std::array<CubeFace, 6> FACES = {{
+            {{0, 0, -1}, {{{0, 0, 0}, {1, 0, 0}, {1, 1, 0}, {0, 1, 0}}}, {{{0, 0}, {1, 0}, {1, 1}, {0, 1}}}},
+            {{0, 0, 1}, {{{0, 0, 1}, {0, 1, 1}, {1, 1, 1}, {1, 0, 1}}}, {{{0, 0}, {0, 1}, {1, 1}, {1, 0}}}},
+            {{-1, 0, 0}, {{{0, 0, 0}, {0, 1, 0}, {0, 1, 1}, {0, 0, 1}}}, {{{0, 1}, {1, 1}, {1, 0}, {0, 0}}}},
+            {{1, 0, 0}, {{{1, 1, 1}, {1, 1, 0}, {1, 0, 0}, {1, 0, 1}}}, {{{1, 0}, {1, 1}, {0, 1}, {0, 0}}}},
+            {{0, -1, 0}, {{{0, 0, 0}, {0, 0, 1}, {1, 0, 1}, {1, 0, 0}}}, {{{0, 1}, {0, 0}, {1, 0}, {1, 1}}}},
+            {{0, 1, 0}, {{{0, 1, 0}, {1, 1, 0}, {1, 1, 1}, {0, 1, 1}}}, {{{0, 1}, {1, 1}, {1, 0}, {0, 0}}}}
+    }};
+}
@@ -0,0 +1,18 @@
+//
+// Created on 10/19/2026.
+//
+#pragma once
+
+#include <GL/glew.h>
+
+/// Anything the RenderQueue can draw: it owns geometry behind a vertex array and knows how to issue its draw call.
+class Drawable {
+public:
+    virtual ~Drawable() = default;
+
+    /// Binds the geometry and issues the draw call(s)
+    virtual void draw() const = 0;
+
+    /// The vertex array used to draw, used to group draws sharing geometry state
+    [[nodiscard]] virtual GLuint getVaoId() const = 0;
+};
@@ -12,6 +12,12 @@
 #include "shader.h"
 #include "player.h"
 #include "chunks.h"
+#include "chunk_renderer.h"
+#include "job_system.h"
+#include "frame_stats.h"
+#include "input.h"
+
+class FastNoise;
 
 #if defined __unix__ || _MSC_VER >= 1914
 namespace fs = std::filesystem;
@@ -20,6 +26,24 @@ namespace fs = std::experimental::filesystem::v1;
 #endif
 
 
+/// Totals of a headless run, written to its report along with the frame statistics
+struct HeadlessTotals {
+    unsigned int frames = 0;
+    unsigned long long chunksBaked = 0;
+    unsigned long long visibleChunks = 0;
+    unsigned long long culledChunks = 0;
+    double totalMs = 0.0;
+    uint64_t worldHash = 0;
+};
+
+/// The shaders of the render loop
+struct EngineShaders {
+    std::unique_ptr<Shader> basic;
+    std::unique_ptr<Shader> light;
+    std::unique_ptr<Shader> sun;
+    std::unique_ptr<Shader> skybox;
+};
+
 /// Basically the entry point into the game. Orchestrates all the systems.
 class Engine {
 private:
@@ -28,14 +52,42 @@ private:
     unsigned int windowHeight = EngineConstants::DEFAULT_WINDOW_HEIGHT;
     Config config;
     WorldInfo worldInfo;
+    std::unique_ptr<JobSystem> jobSystem;
     std::unique_ptr<Player> player;
     std::unique_ptr<ChunkManager> chunkManager;
     std::unique_ptr<Skybox> skybox;
     std::unique_ptr<Sun> sun;
+    std::unique_ptr<ChunkRenderer> chunkRenderer;
+    EngineShaders shaders;
+    FrameStats frameStats;
+    Input input;
+    bool glContext = false;
+    double worldGenerationMs = 0.0;
+    bool memoryReportRequested = false; // set by F3, handled at the start of the next frame
+
+    /** Creates the context of a headless run: a hidden window, or an OSMesa context on GLFW's null platform when
+     * there's no display at all.
+     *
+     * @return false if no context could be created, in which case the run goes on without OpenGL
+     */
+    bool createHeadlessContext();
+
+    /// Waits for the shaders to be linked, checks them and sets their samplers. Called just before the first frame.
+    void finishShaders();
+
+    /// Frees everything holding GL objects, then the context. Called at the end of a run.
+    void destroyContext();
+
+    /// Writes the report of a headless run to the path given in the config
+    void writeHeadlessReport(const HeadlessTotals &totals) const;
 
     /// Generates the heightmap for the world using simplex method and renders it
     void generateWorld();
 
+    /// Fills a single XZ column of the terrain. Only touches the chunk containing the column, so columns of different
+    /// chunks can be generated in parallel.
+    void generateColumn(const FastNoise &noiseGen, unsigned int x, unsigned int z) const;
+
     /// Takes in a set of coordinates and renders a tree on top of that block
     void addTree(unsigned int x, unsigned int y, unsigned int z) const;
 
@@ -49,9 +101,20 @@ private:
 public:
     explicit Engine(Config config);
 
+    /** Issues the compile and link of the render loop's shaders without waiting for them, so that a driver with
+     * parallel shader compile builds them while the databases and the world are loaded. To be called right after the
+     * constructor, timed as a startup stage of its own. Does nothing when headless or without an OpenGL context.
+     */
+    void startShaders();
+
     /// Runs the main game loop.
     void runLoop();
 
+    /** Flies the camera along a fixed path for the configured number of frames, without input or a visible window,
+     * then writes a JSON report. Without an OpenGL context, the chunk meshes are baked and culled but not uploaded.
+     */
+    void runHeadless();
+
     /// initializes the game world
     void init();
 
@@ -60,6 +123,9 @@ public:
 
     [[nodiscard]] inline GLFWwindow *getWindow() const { return window; };
 
+    /// Returns false when running headless without an OpenGL context, in which case nothing may touch OpenGL
+    [[nodiscard]] inline bool hasGLContext() const { return glContext; }
+
     [[nodiscard]] inline unsigned int getWindowWidth() const { return windowWidth; }
 
     [[nodiscard]] inline unsigned int getWindowHeight() const { return windowHeight; }
@@ -70,6 +136,24 @@ public:
 
     inline std::unique_ptr<ChunkManager> &getChunkManager() { return chunkManager; }
 
+    inline JobSystem &getJobSystem() { return *jobSystem; }
+
+    /// Returns the input of the current tick
+    [[nodiscard]] inline const Input &getInput() const { return input; }
+
+    /** Hashes the world's blocks and the player's position. Replaying a recording on the same seed gives the same
+     * hash as the recorded session.
+     *
+     * @return the hash of the world state
+     */
+    [[nodiscard]] uint64_t computeWorldHash() const;
+
+    /** Measures the memory used by the world, the chunk meshes and the sounds, and logs the usage of every subsystem
+     *
+     * @param writeFile also write the report to EngineConstants::MEMORY_REPORT_PATH
+     */
+    void reportMemory(bool writeFile) const;
+
     Engine(const Engine &) = delete;
 
     Engine &operator=(const Engine &) = delete;
@@ -3,6 +3,8 @@
 //
 #pragma once
 
+#include <cstdint>
+
 namespace EngineConstants {
     static constexpr size_t DEFAULT_WINDOW_WIDTH = 1024;
     static constexpr size_t DEFAULT_WINDOW_HEIGHT = 768;
@@ -18,4 +20,39 @@ namespace EngineConstants {
     static constexpr size_t CHUNK_LENGTH = 16;
 
     static constexpr size_t DEFAULT_WORLD_HEIGHT = 16;
+
+    static constexpr float NEAR_PLANE = 0.1f;
+    static constexpr float FAR_PLANE = 96.0f;
+
+    /// Written at shutdown with the frame time statistics of the run
+    static constexpr const char *FRAME_STATS_PATH = "frame_stats.json";
+
+    /// Written after the first frame with the time taken by each step of the startup
+    static constexpr const char *STARTUP_REPORT_PATH = "startup_report.json";
+
+    /// The archive of all the resources made by tools/pack_resources.py, used instead of resources/ when present
+    static constexpr const char *RESOURCE_PACK_PATH = "resources.pack";
+
+    /// Holds the mipmapped and compressed textures baked from resources/textures
+    static constexpr const char *TEXTURE_CACHE_DIR = "texture_cache";
+
+    /// Holds the indexed binary meshes baked from resources/models
+    static constexpr const char *MESH_CACHE_DIR = "mesh_cache";
+
+    /// With --lazy-assets, how many bytes of textures and models may stay resident before the least recently used
+    /// ones are evicted
+    static constexpr int64_t TEXTURE_RESIDENCY_BUDGET = 32 * 1024 * 1024;
+    static constexpr int64_t MODEL_RESIDENCY_BUDGET = 4 * 1024 * 1024;
+
+    /// Sound files from this size on (compressed) are music, streamed rather than decoded whole
+    static constexpr uint64_t SOUND_STREAMING_THRESHOLD = 256 * 1024;
+
+    /// Written at shutdown with the memory used by each subsystem
+    static constexpr const char *MEMORY_REPORT_PATH = "memory_report.json";
+
+    /// Number of frames a headless run lasts unless told otherwise
+    static constexpr unsigned int DEFAULT_HEADLESS_FRAMES = 600;
+    static constexpr const char *HEADLESS_REPORT_PATH = "headless_report.json";
+    static constexpr float HEADLESS_CAMERA_HEIGHT = 40.0f;
+    static constexpr float HEADLESS_CAMERA_PITCH = -25.0f;
 }
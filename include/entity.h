@@ -3,11 +3,13 @@
 //
 #pragma once
 
+#include <atomic>
 #include <string>
 #include "shader.h"
 #include "texture_database.h"
 #include "model_database.h"
 #include "transform.h"
+#include "render_queue.h"
 
 typedef unsigned long long int EntityID;
 
@@ -26,15 +28,13 @@ struct BoundingBox {
 class Entity {
 private:
     std::string modelName;
+    size_t modelIndex; // see ModelDatabase::getModelIndex
     BlockID blockId;
     EntityID entityID;
 
 protected:
     Transform transform;
-    static EntityID entityIDCounter;
-
-    std::shared_ptr<TextureInterface> tex;
-    std::shared_ptr<Model> model;
+    static std::atomic<EntityID> entityIDCounter; // entities are created from world generation jobs
 public:
     BoundingBox box{};
 
@@ -48,11 +48,10 @@ public:
     Entity &operator=(Entity &&other) {
         this->entityID = std::move(other.entityID);
         this->modelName = std::move(other.modelName);
+        this->modelIndex = other.modelIndex;
         this->blockId = std::move(other.blockId);
         this->transform = std::move(other.transform);
         this->box = std::move(other.box);
-        this->tex = TextureDatabase::getTextureByBlockId(this->blockId);
-        this->model = ModelDatabase::getModelByName(this->modelName);
         return *this;
     }
 
@@ -60,18 +59,21 @@ public:
     Entity(Entity &&other) {
         this->entityID = std::move(other.entityID);
         this->modelName = std::move(other.modelName);
+        this->modelIndex = other.modelIndex;
         this->blockId = std::move(other.blockId);
         this->transform = std::move(other.transform);
         this->box = std::move(other.box);
-        this->tex = TextureDatabase::getTextureByBlockId(this->blockId);
-        this->model = ModelDatabase::getModelByName(this->modelName);
         this->box = other.box;
     }
 
-    /** Draws the entity into the world
+    /** Submits the entity to the render queue. Its texture and model are looked up here rather than kept, as they
+     * may be loaded lazily: see TextureDatabase and ModelDatabase.
+     * @param queue the render queue of the current frame
+     * @param pass the render pass to draw the entity in
      * @param shader the shader used to customize the render pipeline
+     * @param viewPos the camera position, used to sort draws by depth
      */
-    virtual void draw(Shader &shader);
+    virtual void submit(RenderQueue &queue, RenderPass pass, Shader &shader, const glm::vec3 &viewPos);
 
     /// Gets the blockID of this entity
     inline BlockID getBlockID() const { return this->blockId; }
@@ -85,21 +87,19 @@ public:
 
 class Skybox {
 private:
-    std::shared_ptr<TextureInterface> tex;
-    std::shared_ptr<Model> model;
     std::string modelName;
+    size_t modelIndex;
     BlockID blockId;
 public:
     Skybox(const std::string &str, BlockID id);
 
-    void draw(Shader &shader);
+    /// Submits the skybox to the sky pass of the render queue
+    void submit(RenderQueue &queue, Shader &shader);
 };
 
 class Sun : public Entity {
 public:
     Sun(const std::string &str, BlockID id);
 
-    void draw(Shader &shader) override;
-
     void update(float dt);
 };
\ No newline at end of file
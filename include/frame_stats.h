@@ -0,0 +1,118 @@
+//
+// Created on 10/19/2026.
+//
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/// The timings recorded every frame
+enum FrameMetric {
+    FRAME_TIME = 0,      // wall time between the starts of two frames
+    CPU_TIME = 1,        // the frame without waiting for the swap
+    SIMULATION_TIME = 2, // input and physics
+    SUBMIT_TIME = 3,     // culling, building, sorting and issuing the draws
+    SWAP_TIME = 4,       // swapping buffers and polling events, includes waiting for vsync
+    FRAME_METRIC_COUNT = 5
+};
+
+/** Millisecond histogram with fixed width buckets. Percentiles are exact to the bucket width; the mean and the max
+ * are exact.
+ */
+class FrameHistogram {
+private:
+    std::vector<uint32_t> buckets;
+    uint64_t count = 0;
+    double sum = 0.0;
+    double max = 0.0;
+
+public:
+    /// Width of a bucket in milliseconds
+    static constexpr double BUCKET_WIDTH_MS = 0.1;
+
+    /// Samples above this land in the last bucket (their exact value still counts for the mean and the max)
+    static constexpr double RANGE_MS = 250.0;
+
+    FrameHistogram();
+
+    void record(double milliseconds);
+
+    void reset();
+
+    /// Returns the value under which the given fraction (0 to 1) of the samples fall
+    [[nodiscard]] double percentile(double fraction) const;
+
+    [[nodiscard]] inline double mean() const { return count == 0 ? 0.0 : sum / static_cast<double>(count); }
+
+    [[nodiscard]] inline double getMax() const { return max; }
+
+    [[nodiscard]] inline uint64_t getCount() const { return count; }
+};
+
+/** Collects per-frame timings, logs a summary periodically and writes a report at shutdown.
+ *
+ * Two sets of histograms are kept: one for the current reporting interval, reset after each periodic log, and one for
+ * the whole run, used for the final report.
+ */
+class FrameStats {
+public:
+    typedef std::chrono::steady_clock Clock;
+
+    /// Frames taking longer than this are counted as hitches (two frames at 60Hz)
+    static constexpr double HITCH_THRESHOLD_MS = 1000.0 / 30.0;
+
+    /// Seconds between two periodic logs
+    static constexpr double REPORT_INTERVAL_SECONDS = 5.0;
+
+    FrameStats();
+
+    /// Returns the current time, to be passed to elapsedMs
+    static inline Clock::time_point now() { return Clock::now(); }
+
+    /// Milliseconds elapsed since the given time
+    static inline double elapsedMs(Clock::time_point since) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - since).count();
+    }
+
+    /// Records a timing of the current frame
+    void record(FrameMetric metric, double milliseconds);
+
+    /// Closes the current frame. Logs the interval's summary if it is due.
+    void endFrame();
+
+    /** Writes the statistics of the whole run as JSON
+     *
+     * @param path the file to write
+     * @return true if the file was written
+     */
+    bool writeReport(const std::string &path) const;
+
+    /** Writes the statistics of every metric over the whole run as a JSON object
+     *
+     * @param out the stream to write to
+     * @param indent the indentation of the line the object starts on
+     */
+    void writeMetrics(std::ostream &out, const std::string &indent) const;
+
+    [[nodiscard]] inline const FrameHistogram &getTotal(FrameMetric metric) const { return total[metric]; }
+
+    [[nodiscard]] inline uint64_t getHitchCount() const { return totalHitches; }
+
+private:
+    std::array<FrameHistogram, FRAME_METRIC_COUNT> interval{};
+    std::array<FrameHistogram, FRAME_METRIC_COUNT> total{};
+    uint64_t intervalHitches = 0;
+    uint64_t totalHitches = 0;
+    Clock::time_point intervalStart;
+    Clock::time_point runStart;
+
+    /// Logs the summary of the current interval and starts a new one
+    void logInterval();
+};
+
+/// Returns the name of a metric, as used in logs and reports
+const char *getFrameMetricName(FrameMetric metric);
@@ -0,0 +1,127 @@
+//
+// Created on 10/19/2026.
+//
+#pragma once
+
+#include <GL/glew.h>
+#include <array>
+
+/// The kinds of OpenGL state changes tracked by the GLStateCache
+enum GLStateKind {
+    PROGRAM_BIND = 0,
+    VERTEX_ARRAY_BIND = 1,
+    ACTIVE_TEXTURE = 2,
+    TEXTURE_BIND = 3,
+    DEPTH_FUNC = 4,
+    CAPABILITY = 5,
+    DEPTH_MASK = 6,
+    GL_STATE_KIND_COUNT = 7
+};
+
+/// Number of state changes that reached the driver versus the ones dropped as redundant.
+struct GLStateCounters {
+    std::array<unsigned int, GL_STATE_KIND_COUNT> issued{};
+    std::array<unsigned int, GL_STATE_KIND_COUNT> filtered{};
+
+    [[nodiscard]] unsigned int totalIssued() const {
+        unsigned int total = 0;
+        for (auto count : issued)
+            total += count;
+        return total;
+    }
+
+    [[nodiscard]] unsigned int totalFiltered() const {
+        unsigned int total = 0;
+        for (auto count : filtered)
+            total += count;
+        return total;
+    }
+};
+
+/** Shadows the OpenGL state the renderer touches so that redundant binds never reach the driver. (singleton)
+ *
+ * Every glUseProgram, glBindVertexArray, glActiveTexture/glBindTexture, glDepthFunc, glDepthMask and
+ * glEnable/glDisable issued by the engine should go through here, otherwise the shadowed state goes stale and
+ * invalidate() must be called.
+ */
+class GLStateCache {
+private:
+    static constexpr GLuint UNKNOWN = 0xFFFFFFFF;
+    static constexpr unsigned int MAX_TEXTURE_UNITS = 8;
+    static constexpr unsigned int TEXTURE_TARGET_COUNT = 2; // GL_TEXTURE_2D, GL_TEXTURE_CUBE_MAP
+    static constexpr unsigned int CAPABILITY_COUNT = 3; // GL_DEPTH_TEST, GL_CULL_FACE, GL_BLEND
+
+    GLStateCache();
+
+    GLStateCache(const GLStateCache &) = delete;
+
+    GLStateCache &operator=(const GLStateCache &) = delete;
+
+    static GLStateCache instance;
+
+    GLuint program = UNKNOWN;
+    GLuint vertexArray = UNKNOWN;
+    GLuint activeTexture = UNKNOWN;
+    std::array<std::array<GLuint, TEXTURE_TARGET_COUNT>, MAX_TEXTURE_UNITS> textures{};
+    GLuint depthFunction = UNKNOWN;
+    GLuint depthWrite = UNKNOWN;
+    std::array<GLuint, CAPABILITY_COUNT> capabilities{};
+
+    GLStateCounters currentFrame{};
+    GLStateCounters lastFrame{};
+
+    /// Records a state change as either issued or filtered
+    inline void count(GLStateKind kind, bool issued) {
+        if (issued)
+            currentFrame.issued[kind]++;
+        else
+            currentFrame.filtered[kind]++;
+    }
+
+    /// Sets the active texture unit if it is not already active
+    void setActiveTexture(GLenum unit);
+
+public:
+    /// Sets the current program (glUseProgram)
+    static void useProgram(GLuint programId);
+
+    /// Binds a vertex array object (glBindVertexArray)
+    static void bindVertexArray(GLuint vaoId);
+
+    /** Binds a texture to the given texture unit (glActiveTexture + glBindTexture)
+     *
+     * @param unit the texture unit, i.e. GL_TEXTURE0
+     * @param target GL_TEXTURE_2D or GL_TEXTURE_CUBE_MAP
+     * @param textureId the texture to bind
+     */
+    static void bindTexture(GLenum unit, GLenum target, GLuint textureId);
+
+    /// Sets the depth comparison function (glDepthFunc)
+    static void depthFunc(GLenum func);
+
+    /// Enables or disables writing to the depth buffer (glDepthMask)
+    static void depthMask(bool enabled);
+
+    /// Enables or disables GL_DEPTH_TEST, GL_CULL_FACE or GL_BLEND (glEnable/glDisable)
+    static void setCapability(GLenum capability, bool enabled);
+
+    /** Records that a texture was deleted: GL reverts every unit it was bound to to texture 0. Must be called with
+     * glDeleteTextures, otherwise a new texture given the same name would be taken as already bound.
+     */
+    static void forgetTexture(GLuint textureId);
+
+    /// Records that a vertex array was deleted, which reverts its binding to 0, see forgetTexture
+    static void forgetVertexArray(GLuint vaoId);
+
+    /// Forgets all shadowed state, so that the next call of every kind reaches the driver.
+    static void invalidate();
+
+    /// Marks the start of a new frame: the counters of the frame that just ended become available.
+    static void beginFrame();
+
+    /// Returns the counters of the last complete frame
+    static const GLStateCounters &getFrameCounters();
+
+    /// Returns the counters accumulated so far in the current frame
+    static const GLStateCounters &getCurrentCounters();
+};
@@ -0,0 +1,113 @@
+//
+// Created on 10/19/2026.
+//
+#pragma once
+
+#include <GLFW/glfw3.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/// The player's actions, one bit each in an InputFrame
+enum InputAction : uint32_t {
+    MOVE_FORWARD = 1u << 0u,
+    MOVE_BACKWARD = 1u << 1u,
+    MOVE_LEFT = 1u << 2u,
+    MOVE_RIGHT = 1u << 3u,
+    JUMP = 1u << 4u,
+    TOGGLE_PERSPECTIVE = 1u << 5u,
+    ROTATE_VIEW = 1u << 6u,
+    BREAK_BLOCK = 1u << 7u,
+    PLACE_BLOCK = 1u << 8u,
+    SELECT_BLOCK_1 = 1u << 9u, // SELECT_BLOCK_1 << n selects the block of key n + 1, up to 9
+};
+
+/// Everything the player did during one simulation tick
+struct InputFrame {
+    uint32_t actions = 0;   // InputAction bits held during the tick
+    float mouseDeltaX = 0.0f;
+    float mouseDeltaY = 0.0f;
+
+    inline bool operator==(const InputFrame &other) const {
+        return actions == other.actions && mouseDeltaX == other.mouseDeltaX && mouseDeltaY == other.mouseDeltaY;
+    }
+};
+
+/// What a recording needs to recreate the session it was made in
+struct RecordingHeader {
+    int seed = 0;
+    unsigned int worldSize = 0;
+    uint32_t tickCount = 0;
+    uint64_t worldHash = 0; // world state hash at the end of the session
+};
+
+/** Source of the player's input, sampled once per simulation tick.
+ *
+ * Live input is polled from GLFW and can be recorded; a recording is replayed tick by tick without any window, so a
+ * session on a seeded world can be reproduced exactly. Recordings are run-length encoded, since most ticks repeat
+ * the previous one.
+ */
+class Input {
+public:
+    /// Starts recording the live ticks, written to the given file by finishRecording
+    void startRecording(const std::string &path);
+
+    /** Writes the ticks recorded so far
+     *
+     * @param header the world and the state it ended in, tickCount is filled in
+     * @return true if the file was written
+     */
+    bool finishRecording(RecordingHeader header);
+
+    /** Loads a recording to replay instead of polling GLFW
+     *
+     * @param path the recording to load
+     * @return true if the file was a valid recording
+     */
+    bool startReplay(const std::string &path);
+
+    /// Accumulates the cursor movement until the next tick (live input only)
+    void addCursorPosition(double x, double y);
+
+    /** Samples the input of the next tick: polls the window, or reads the next recorded tick when replaying
+     *
+     * @param window the window to poll, unused when replaying
+     */
+    void beginTick(GLFWwindow *window);
+
+    /// Returns true if the action is held during the current tick
+    [[nodiscard]] inline bool isDown(uint32_t action) const { return (current.actions & action) != 0; }
+
+    /// Returns true if the action started this tick
+    [[nodiscard]] inline bool wasPressed(uint32_t action) const {
+        return (current.actions & action) != 0 && (previous.actions & action) == 0;
+    }
+
+    [[nodiscard]] inline float getMouseDeltaX() const { return current.mouseDeltaX; }
+
+    [[nodiscard]] inline float getMouseDeltaY() const { return current.mouseDeltaY; }
+
+    [[nodiscard]] inline bool isReplaying() const { return replaying; }
+
+    /// Returns true once every recorded tick has been replayed
+    [[nodiscard]] inline bool isReplayFinished() const { return replaying && replayTick >= ticks.size(); }
+
+    /// Returns the header of the recording being replayed
+    [[nodiscard]] inline const RecordingHeader &getReplayHeader() const { return replayHeader; }
+
+private:
+    InputFrame current{};
+    InputFrame previous{};
+    std::vector<InputFrame> ticks{}; // recorded, or loaded to replay
+    size_t replayTick = 0;
+    bool recording = false;
+    bool replaying = false;
+    std::string recordingPath;
+    RecordingHeader replayHeader{};
+    double cursorX = 0.0, cursorY = 0.0;
+    bool hasCursorPosition = false;
+    float pendingDeltaX = 0.0f, pendingDeltaY = 0.0f;
+
+    /// Reads the held actions from the window
+    static uint32_t pollActions(GLFWwindow *window);
+};
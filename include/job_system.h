@@ -0,0 +1,146 @@
+//
+// Created on 10/19/2026.
+//
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// Where a job is allowed to run
+enum JobAffinity {
+    ANY_THREAD = 0,
+    MAIN_THREAD = 1 // i.e. anything that touches the GL context
+};
+
+struct Job;
+
+/// Refers to a submitted job, used to wait on it or to make other jobs depend on it
+class JobHandle {
+private:
+    std::shared_ptr<Job> job;
+
+    friend class JobSystem;
+
+public:
+    JobHandle() = default;
+
+    explicit JobHandle(std::shared_ptr<Job> job) : job(std::move(job)) {}
+
+    /// Returns true once the job has run (an empty handle is always done)
+    [[nodiscard]] bool isDone() const;
+};
+
+/// Counters of a JobSystem since it was created
+struct JobSystemStats {
+    unsigned long long executed = 0;
+    unsigned long long stolen = 0;
+    unsigned long long mainThreadExecuted = 0;
+};
+
+/** A pool of worker threads that run small jobs.
+ *
+ * Each worker owns a deque: jobs submitted from a worker go to the back of its own deque and are popped from the back
+ * (the most recent job is the one most likely to have its data in cache), while idle workers steal from the front of
+ * the other deques. Jobs can depend on other jobs and only become runnable once all of them are done, which is also
+ * how continuations are expressed. Jobs with MAIN_THREAD affinity are kept in a separate queue that is only run by
+ * runMainThreadJobs(), which the engine calls once per frame.
+ */
+class JobSystem {
+private:
+    struct Worker {
+        std::mutex mutex;
+        std::deque<std::shared_ptr<Job>> jobs;
+    };
+
+    std::vector<std::unique_ptr<Worker>> workers{};
+    std::vector<std::thread> threads{};
+    std::thread::id mainThreadId;
+
+    std::mutex mainThreadMutex;
+    std::deque<std::shared_ptr<Job>> mainThreadJobs{};
+
+    std::mutex sleepMutex;
+    std::condition_variable wakeUp;
+    std::atomic<unsigned int> queuedJobs{0};
+    std::atomic<unsigned int> nextWorker{0};
+    std::atomic<bool> stopping{false};
+
+    std::atomic<unsigned long long> executedCount{0};
+    std::atomic<unsigned long long> stolenCount{0};
+    std::atomic<unsigned long long> mainThreadCount{0};
+
+    /// Body of the worker threads
+    void workerLoop(unsigned int workerIndex);
+
+    /// Puts a job whose dependencies are all done in a queue
+    void schedule(const std::shared_ptr<Job> &job);
+
+    /// Takes a runnable job, from the given worker's own deque first then from the others. Returns nullptr if none.
+    std::shared_ptr<Job> findJob(int workerIndex);
+
+    /// Runs a job and releases the jobs that were waiting on it
+    void execute(const std::shared_ptr<Job> &job);
+
+public:
+    /** Starts the worker threads. The thread creating the JobSystem is taken as the main thread.
+     *
+     * @param workerCount the number of worker threads, 0 to use one less than the number of hardware threads
+     */
+    explicit JobSystem(unsigned int workerCount = 0);
+
+    /// Finishes the queued jobs and joins the workers
+    ~JobSystem();
+
+    JobSystem(const JobSystem &) = delete;
+
+    JobSystem &operator=(const JobSystem &) = delete;
+
+    /** Submits a job
+     *
+     * @param work the function to run
+     * @param dependencies jobs that must be done before this one starts
+     * @param affinity where the job may run
+     * @return a handle to the job
+     */
+    JobHandle submit(std::function<void()> work, const std::vector<JobHandle> &dependencies = {},
+                     JobAffinity affinity = ANY_THREAD);
+
+    /// Submits a job that runs once the given job is done
+    inline JobHandle then(const JobHandle &job, std::function<void()> continuation, JobAffinity affinity = ANY_THREAD) {
+        return submit(std::move(continuation), {job}, affinity);
+    }
+
+    /** Splits [begin, end) into ranges of at most grainSize and runs them as jobs
+     *
+     * @param begin the first index
+     * @param end one past the last index
+     * @param grainSize the number of indices per job
+     * @param work called with the [first, last) range of each job
+     * @return a job that is done once all the ranges are
+     */
+    JobHandle parallelFor(unsigned int begin, unsigned int end, unsigned int grainSize,
+                          const std::function<void(unsigned int, unsigned int)> &work);
+
+    /// Blocks until the job is done. The calling thread runs other jobs (main thread jobs included) while it waits.
+    void wait(const JobHandle &job);
+
+    /// Blocks until all the given jobs are done, see wait()
+    void waitAll(const std::vector<JobHandle> &jobs);
+
+    /** Runs the jobs queued for the main thread. Must be called from the main thread.
+     *
+     * @param maxJobs the maximum number of jobs to run, to bound the time spent per frame
+     * @return the number of jobs run
+     */
+    unsigned int runMainThreadJobs(unsigned int maxJobs = ~0u);
+
+    [[nodiscard]] inline unsigned int getWorkerCount() const { return static_cast<unsigned int>(workers.size()); }
+
+    [[nodiscard]] JobSystemStats getStats() const;
+};
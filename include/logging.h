@@ -0,0 +1,122 @@
+//
+// Created on 10/19/2026.
+//
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "../libs/easylogging++.h"
+
+// Lowest level that is compiled in: 0 trace, 1 debug, 2 info, 3 warning, 4 error. Release builds drop the DEBUG and
+// TRACE logs entirely, including the evaluation of what they print.
+#ifndef ENGINE_LOG_LEVEL
+#ifdef NDEBUG
+#define ENGINE_LOG_LEVEL 2
+#else
+#define ENGINE_LOG_LEVEL 0
+#endif
+#endif
+
+#define ENGINE_LOG_ENABLED_TRACE (ENGINE_LOG_LEVEL <= 0)
+#define ENGINE_LOG_ENABLED_DEBUG (ENGINE_LOG_LEVEL <= 1)
+#define ENGINE_LOG_ENABLED_INFO (ENGINE_LOG_LEVEL <= 2)
+#define ENGINE_LOG_ENABLED_WARNING (ENGINE_LOG_LEVEL <= 3)
+#define ENGINE_LOG_ENABLED_ERROR (ENGINE_LOG_LEVEL <= 4)
+
+/// Same as easylogging's LOG(level), but compiled out when the level is below ENGINE_LOG_LEVEL
+#define ENGINE_LOG(level) if constexpr (!ENGINE_LOG_ENABLED_##level) {} else LOG(level)
+
+/// Logs at most once every given number of milliseconds from this call site, with the number of messages skipped
+#define ENGINE_LOG_EVERY_MS(level, intervalMs) \
+    if constexpr (!ENGINE_LOG_ENABLED_##level) {} \
+    else if (static LogRateLimiter logRateLimiter(intervalMs); !logRateLimiter.allow()) {} \
+    else LOG(level) << logRateLimiter.takeSuppressedNote()
+
+/// Lets through one message per interval, shared by every thread logging from the same call site
+class LogRateLimiter {
+private:
+    int64_t intervalMs;
+    std::atomic<int64_t> lastAllowedMs;
+    std::atomic<uint64_t> suppressed{0};
+    std::atomic<uint64_t> suppressedBeforeAllowed{0};
+
+    static int64_t nowMs();
+
+public:
+    explicit LogRateLimiter(int64_t intervalMs) : intervalMs(intervalMs), lastAllowedMs(nowMs() - intervalMs) {}
+
+    /// Returns true if a message can be logged now, otherwise counts it as suppressed
+    bool allow();
+
+    /// Returns "(N similar messages suppressed) " for the message that was just allowed, or nothing if none were
+    std::string takeSuppressedNote();
+};
+
+/** Writes the logs from a background thread, so the threads that log never wait on the console or the log file.
+ * (singleton)
+ *
+ * Once started, easylogging's default dispatch is replaced: each message is formatted on the thread that logs it and
+ * moved into a fixed size ring, which the writer thread empties. When the ring is full new messages are dropped
+ * rather than blocking the caller, and the number dropped is logged once the writer catches up. FATAL messages are
+ * written immediately, since the program aborts right after them.
+ */
+class AsyncLogSink {
+public:
+    /// Replaces easylogging's default dispatch with the ring and starts the writer thread
+    static void start(size_t capacity = DEFAULT_CAPACITY);
+
+    /// Writes what's left in the ring, stops the writer thread and restores easylogging's default dispatch
+    static void stop();
+
+    /// Returns the number of messages dropped because the ring was full
+    static uint64_t getDroppedCount();
+
+    static constexpr size_t DEFAULT_CAPACITY = 4096;
+
+private:
+    /// A formatted message, waiting to be written
+    struct Entry {
+        std::string line;        // as written to the file
+        std::string consoleLine; // as written to the console, with colors, empty if it doesn't go to the console
+        std::string filename;    // empty if it doesn't go to a file
+    };
+
+    AsyncLogSink() = default;
+
+    /// Joins the writer if stop wasn't called, e.g. when main returns early
+    ~AsyncLogSink();
+
+    AsyncLogSink(const AsyncLogSink &) = delete;
+
+    AsyncLogSink &operator=(const AsyncLogSink &) = delete;
+
+    static AsyncLogSink instance;
+
+    std::mutex mutex;
+    std::condition_variable wakeWriter;
+    std::vector<Entry> ring{};
+    size_t head = 0, size = 0;
+    uint64_t dropped = 0, droppedReported = 0;
+    bool running = false;
+    std::thread writer;
+    std::mutex outputMutex;
+    std::unordered_map<std::string, std::ofstream> files{};
+
+    friend class RingLogDispatchCallback;
+
+    /// Adds a message to the ring, or drops it if the ring is full
+    void push(Entry &&entry);
+
+    /// Writes messages straight away, on the calling thread
+    void write(const std::vector<Entry> &entries);
+
+    void writerLoop();
+};
@@ -0,0 +1,37 @@
+//
+// Created on 10/19/2026.
+//
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+/// A whole file mapped read-only in memory, the pages are only read from disk when they're touched
+class MappedFile {
+private:
+#ifdef _WIN32
+    void *file = nullptr;
+    void *mapping = nullptr;
+#else
+    int descriptor = -1;
+#endif
+    const unsigned char *data = nullptr;
+    size_t size = 0;
+
+public:
+    /// Maps a file, check isOpen() to know if it succeeded
+    explicit MappedFile(const std::string &path);
+
+    ~MappedFile();
+
+    MappedFile(const MappedFile &) = delete;
+
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    /// False if the file couldn't be opened or is empty
+    [[nodiscard]] inline bool isOpen() const { return data != nullptr; }
+
+    [[nodiscard]] inline const unsigned char *getData() const { return data; }
+
+    [[nodiscard]] inline size_t getSize() const { return size; }
+};
@@ -0,0 +1,78 @@
+//
+// Created on 10/19/2026.
+//
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+/// What the memory is used by
+enum MemoryCategory {
+    WORLD_ENTITIES = 0,   // Entity objects, with the shared_ptr control block they're allocated with
+    WORLD_INDICES = 1,    // the chunks and their two maps of shared_ptr<Entity>, by ID and by block type
+    CHUNK_MESHES_CPU = 2, // what the chunk meshes keep on the CPU: sub mesh lists and the water faces to sort
+    CHUNK_MESHES_GPU = 3, // chunk geometry in the chunk arena
+    MODEL_VERTICES = 4,   // model vertices in the model arena (the CPU copy is dropped after the upload)
+    TEXTURE_STAGING = 5,  // decoded images waiting to be uploaded, on the CPU
+    TEXTURES_GPU = 6,     // uploaded textures, estimated from their size and format
+    SOUNDS = 7,           // decoded samples of the sound sources that were loaded and aren't streamed
+    MEMORY_CATEGORY_COUNT = 8
+};
+
+/// Returns the name of a category, as used in the reports
+const char *getMemoryCategoryName(MemoryCategory category);
+
+/** Keeps count of the bytes and objects used by each subsystem. (singleton)
+ *
+ * Resources that are loaded and released one by one (textures, models, staging images) are counted as they come and
+ * go, and remember their peak. Containers that change all the time (the world, the chunk meshes, the sounds) are
+ * measured on demand and stored with set(), which keeps counting from the hot paths free.
+ */
+class MemoryStats {
+private:
+    struct Counter {
+        std::atomic<int64_t> bytes{0};
+        std::atomic<int64_t> peakBytes{0};
+        std::atomic<int64_t> objects{0};
+    };
+
+    MemoryStats() = default;
+
+    MemoryStats(const MemoryStats &) = delete;
+
+    MemoryStats &operator=(const MemoryStats &) = delete;
+
+    static MemoryStats instance;
+
+    std::array<Counter, MEMORY_CATEGORY_COUNT> counters{};
+
+    static void updatePeak(Counter &counter, int64_t bytes);
+
+public:
+    /// Counts memory taken by a category
+    static void add(MemoryCategory category, int64_t bytes, int64_t objects = 1);
+
+    /// Counts memory given back by a category
+    static void remove(MemoryCategory category, int64_t bytes, int64_t objects = 1);
+
+    /// Replaces the usage of a category with a new measurement
+    static void set(MemoryCategory category, int64_t bytes, int64_t objects);
+
+    [[nodiscard]] static int64_t getBytes(MemoryCategory category);
+
+    [[nodiscard]] static int64_t getPeakBytes(MemoryCategory category);
+
+    [[nodiscard]] static int64_t getObjects(MemoryCategory category);
+
+    /// Logs the usage of every category, with its peak and the average size of its objects
+    static void logBreakdown();
+
+    /** Writes the usage of every category as JSON
+     *
+     * @param path the file to write
+     * @return true if the file was written
+     */
+    static bool writeReport(const std::string &path);
+};
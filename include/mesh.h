@@ -3,6 +3,8 @@
 //
 #pragma once
 
+#include <cstdint>
+#include <string>
 #include <vector>
 #include <glm/glm.hpp>
 
@@ -13,8 +15,28 @@ struct Vertex {
     glm::vec2 textureCoordinate{};
 };
 
-/// A Mesh has a name, and a set of vertices
+/** A Vertex packed in 16 bytes: a half-float position, a signed normalized 10:10:10:2 normal (GL_INT_2_10_10_10_REV)
+ * and 16-bit normalized texture coordinates, which must be in [0, 1]. See quantizeVertices.
+ */
+struct QuantizedVertex {
+    uint16_t position[3];
+    uint16_t padding;
+    uint32_t normal;
+    uint16_t textureCoordinate[2];
+};
+
+/// A vertex of baked chunk geometry. The position is in world space, the local position is the position inside the
+/// block, used to sample cube maps.
+struct ChunkVertex {
+    glm::vec3 position{};
+    glm::vec3 normal{};
+    glm::vec2 textureCoordinate{};
+    glm::vec3 localPosition{};
+};
+
+/// A Mesh has a name, a set of unique vertices, and the triangles made of them (three indices each)
 struct Mesh {
     std::string meshName{};
     std::vector<Vertex> vertices{};
+    std::vector<uint32_t> indices{};
 };
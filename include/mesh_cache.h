@@ -0,0 +1,35 @@
+//
+// Created on 10/19/2026.
+//
+#pragma once
+
+#include <string>
+#include "mesh.h"
+
+/** Keeps a compact binary version of every .obj model on disk, so it doesn't have to be parsed at each launch. (static)
+ *
+ * Each model gets a file in EngineConstants::MESH_CACHE_DIR holding its unique vertices and its index buffer, stored
+ * with 16-bit indices when the mesh has few enough vertices. The mesh is stored as given, so optimize it before.
+ * Entries are tagged with the size and modification time of the .obj they were made from, as given by
+ * ResourcePack::describe, so an edited model is parsed again without the .obj having to be read to find out.
+ */
+class MeshCache {
+public:
+    MeshCache() = delete;
+
+    /** Reads the cached version of a model. Can be called from any thread.
+     *
+     * @param sourcePath the .obj file the entry was made from
+     * @param mesh set to the cached mesh
+     * @return false if there is no usable entry: missing, made from another version of the file, or damaged
+     */
+    static bool load(const std::string &sourcePath, Mesh &mesh);
+
+    /** Writes the cache entry of a model. Can be called from any thread.
+     *
+     * @param sourcePath the .obj file the mesh was loaded from
+     * @param mesh the mesh to cache
+     * @return true if the entry was written
+     */
+    static bool store(const std::string &sourcePath, const Mesh &mesh);
+};
@@ -0,0 +1,47 @@
+//
+// Created on 10/19/2026.
+//
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "mesh.h"
+
+/// Size of the FIFO post-transform vertex cache simulated to measure index orders, typical of current GPUs
+static constexpr unsigned int SIMULATED_VERTEX_CACHE_SIZE = 16;
+
+/** Reorders the triangles of an index buffer so that they reuse the vertices recently transformed by the GPU, with Tom
+ * Forsyth's linear-speed vertex cache optimization. The triangles themselves don't change.
+ *
+ * @param indices the triangle list to reorder
+ * @param vertexCount the number of vertices the indices refer to
+ */
+void optimizeVertexCache(std::vector<uint32_t> &indices, size_t vertexCount);
+
+/** Reorders the vertices in the order the indices first use them, so that they're fetched close to each other, and
+ * drops the vertices no triangle uses. The indices are remapped accordingly.
+ */
+void optimizeVertexFetch(std::vector<Vertex> &vertices, std::vector<uint32_t> &indices);
+
+/** Optimizes a mesh for the vertex cache, then for vertex fetch. The original triangle order is kept if the simulated
+ * cache did better with it.
+ */
+void optimizeMesh(Mesh &mesh);
+
+/** Simulates a FIFO vertex cache over an index buffer
+ *
+ * @param indices a triangle list
+ * @param vertexCount the number of vertices the indices refer to
+ * @param cacheSize the number of vertices the cache holds
+ * @return the average number of vertices transformed per triangle (ACMR): 3 without any reuse, 0.5 at best
+ */
+float averageCacheMissRatio(const std::vector<uint32_t> &indices, size_t vertexCount,
+                            unsigned int cacheSize = SIMULATED_VERTEX_CACHE_SIZE);
+
+/** Packs vertices into the QuantizedVertex format
+ *
+ * @param vertices the vertices to pack
+ * @param quantized set to the packed vertices
+ * @return false if a texture coordinate is outside [0, 1], in which case the vertices can't be packed
+ */
+bool quantizeVertices(const std::vector<Vertex> &vertices, std::vector<QuantizedVertex> &quantized);
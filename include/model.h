@@ -8,25 +8,53 @@
 #include "mesh.h"
 #include "shader.h"
 #include "texture.h"
+#include "drawable.h"
+#include "buffer_arena.h"
 
-/// A model is an object that is renderable by OpenGL
-class Model {
+/** A model is an object that is renderable by OpenGL. Its vertices, followed by its indices, live in one range of a
+ * shared BufferArena, and it is drawn with indices. The vertices are either full Vertex or, when quantized,
+ * QuantizedVertex.
+ */
+class Model : public Drawable {
 private:
-    GLuint vaoID{}, vboID{}, iboId{};
-    GLuint numVertices;
+    GLuint vaoID{};
+    BufferArena *arena;
+    BufferArena::Handle allocation;
+    GLuint numIndices;
+    GLenum indexType;         // GL_UNSIGNED_SHORT when the vertices fit, GL_UNSIGNED_INT otherwise
+    GLsizei vertexStride;
+    GLsizeiptr vertexBytes;
+    GLsizeiptr indexBytes;
     std::string modelName;
 
 public:
-    Model(Mesh &mesh);
+    /** Uploads the mesh's vertices and indices to the arena
+     *
+     * @param mesh the mesh to upload
+     * @param arena the arena holding the vertices, must outlive the model's buffers
+     * @param quantize packs the vertices as QuantizedVertex if the mesh allows it (see quantizeVertices)
+     */
+    Model(Mesh &mesh, BufferArena &arena, bool quantize = false);
 
     /** Draws this model with the given shader.
      *
      * @param shader the shader
      */
-    void draw() const;
+    void draw() const override;
 
     inline std::string getModelName() const { return this->modelName; }
 
+    inline GLuint getVaoId() const override { return this->vaoID; }
+
+    /// Returns true if the vertices are stored as QuantizedVertex
+    inline bool isQuantized() const { return this->vertexStride == sizeof(QuantizedVertex); }
+
+    /// Size in bytes of the vertices on the GPU
+    inline GLsizeiptr getVertexBytes() const { return this->vertexBytes; }
+
+    /// Size in bytes of the indices on the GPU
+    inline GLsizeiptr getIndexBytes() const { return this->indexBytes; }
+
     /// Binds this model's buffers for rendering
     void bindBuffers() const;
 
@@ -10,6 +10,9 @@
 #include "../libs/easylogging++.h"
 #include "objloader.h"
 #include "model.h"
+#include "asset_residency.h"
+#include "engine_constants.h"
+#include "job_system.h"
 
 #if defined(__unix__) || _MSC_VER >= 1914
 namespace fs = std::filesystem;
@@ -17,7 +20,13 @@ namespace fs = std::filesystem;
 namespace fs = std::filesystem;
 #endif
 
-/// The Model Database loads models in the resources/models/ folder to be available at run time.
+/** The Model Database loads models in the resources/models/ folder to be available at run time. A model is named after
+ * its file: models/steve.obj is "steveModel".
+ *
+ * By default every model is loaded by init. When lazy, only the cube is, to stand in for the others until they've been
+ * loaded in the background the first time they're asked for. Models not used for a frame are evicted, least recently
+ * used first, once the resident ones take more than EngineConstants::MODEL_RESIDENCY_BUDGET.
+ */
 class ModelDatabase {
 private:
     ModelDatabase();
@@ -27,21 +36,80 @@ private:
     ModelDatabase &operator=(const ModelDatabase &) = delete;
 
     static ModelDatabase instance;
-    std::unordered_map<std::string, std::shared_ptr<Model>> models;
+    std::unique_ptr<BufferArena> arena; // declared before the models so that it outlives them
+    std::unordered_map<std::string, size_t> modelIndices; // name => index, not modified after init
+    std::vector<std::string> paths;                       // indexed like the models
+    std::vector<std::shared_ptr<Model>> models;           // empty while not resident
+    std::shared_ptr<Model> missing;                       // returned for unknown names
+
+    bool quantize = false;
+    bool lazy = false;
+    JobSystem *jobs = nullptr;
+    AssetResidency residency{EngineConstants::MODEL_RESIDENCY_BUDGET}; // indexed like the models, when lazy
+    size_t placeholder = NO_MODEL;
+
+    /** Reads a model's mesh from the mesh cache, or parses and optimizes it. Safe to call from any thread.
+     *
+     * @param path the resource path of the .obj file
+     */
+    static Mesh loadMesh(const std::string &path);
+
+    /// Uploads a loaded mesh as the model at the given index
+    void addModel(size_t index, Mesh &mesh);
+
+    /// Starts loading a model in the background, when lazy
+    void requestLoad(size_t index);
 
 public:
+    /// Size in bytes of each page of the arena holding the models' vertices
+    static constexpr GLsizeiptr ARENA_PAGE_SIZE = 4 * 1024 * 1024;
+
+    /// The index of a name no model has
+    static constexpr size_t NO_MODEL = static_cast<size_t>(-1);
 
     ~ModelDatabase();
 
-    /// Initializes the Model Database. Should only be called once during program execution.
-    static void init();
+    /** Initializes the Model Database. Should only be called once during program execution.
+     *
+     * @param quantize stores the models' vertices as QuantizedVertex when they allow it
+     * @param jobs loads the models in the background, when lazy
+     * @param lazy only load the models when they're first used, see the class
+     */
+    static void init(bool quantize, JobSystem &jobs, bool lazy = false);
 
-    /** Returns a pointer to a Model based on its name
+    /** Looks the index of a model up. Unlike getModel, this can be called from any thread once init returned.
+     *
+     * @param modelName the model to look for
+     * @return its index, NO_MODEL if there is no such model
+     */
+    [[nodiscard]] static size_t getModelIndex(const std::string &modelName);
+
+    /** Returns a model by index. When lazy, this counts as a use of the model and starts loading it if it isn't
+     * resident, returning the cube until then, so it must be called from the main thread.
+     *
+     * @param index the model's index, from getModelIndex
+     * @return a pointer to the model if it exists, otherwise a nullptr.
+     */
+    static std::shared_ptr<Model> &getModel(size_t index);
+
+    /** Returns a pointer to a Model based on its name, see getModel
      *
      * @param modelName the model to look for
      * @return a pointer to the model if it exists, otherwise a nullptr.
      */
     static std::shared_ptr<Model> &getModelByName(const std::string &modelName);
+
+    /// Evicts the least recently used models over the budget, when lazy. Called once per frame, after drawing.
+    static void update();
+
+    /// Loads, evictions and resident bytes of the lazily loaded models
+    [[nodiscard]] static AssetResidencyStats getResidencyStats();
+
+    /// Frees the models and their arena. Called before the context is destroyed, from the thread that owns it.
+    static void destroy();
+
+    /// Returns the usage of the arena holding the models' vertices
+    static BufferArenaStats getArenaStats();
 };
 
 /// Different model names namespace, since enums don't support strings
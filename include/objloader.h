@@ -4,18 +4,37 @@
 #pragma once
 
 #include <iostream>
+#include <unordered_map>
 #include "../libs/tiny_obj_loader.h"
 #include "mesh.h"
+#include "resource_pack.h"
+
+/// Identifies a vertex of an .obj file by its position, normal and texture coordinate indices
+struct ObjVertexKey {
+    int position, normal, textureCoordinate;
+
+    inline bool operator==(const ObjVertexKey &other) const {
+        return position == other.position && normal == other.normal && textureCoordinate == other.textureCoordinate;
+    }
+};
+
+struct ObjVertexKeyHash {
+    inline size_t operator()(const ObjVertexKey &key) const {
+        size_t hash = std::hash<int>()(key.position);
+        hash = hash * 31 + std::hash<int>()(key.normal);
+        return hash * 31 + std::hash<int>()(key.textureCoordinate);
+    }
+};
 
 //todo what if multiple meshes per obj file?
-/** Loads and reads data from an .obj file
+/** Loads and reads data from an .obj file. Corners that share the same position, normal and texture coordinate become
+ * a single vertex.
  *
- * @param path the path to the .obj file
- * @return a pair of the mesh name and set of vertices
+ * @param path the resource path of the .obj file, i.e. "models/cube.obj"
+ * @return the mesh, named after the last shape of the file
  */
-inline std::pair<std::string, std::vector<Vertex>> loadOBJ(const char *path) {
-    std::string meshName;
-    std::vector<Vertex> verticesOut;
+inline Mesh loadOBJ(const char *path) {
+    Mesh mesh;
 
     tinyobj::attrib_t attrib;
     std::vector<tinyobj::shape_t> shapes;
@@ -23,7 +42,14 @@ inline std::pair<std::string, std::vector<Vertex>> loadOBJ(const char *path) {
     std::string warn;
     std::string err;
 
-    bool ret = tinyobj::LoadObj(&attrib, &shapes, &materials, &warn, &err, path);
+    // parsed straight from the resource, the models have no material libraries to look up next to them
+    Resource file = ResourcePack::load(path);
+    if (!file.isValid()) {
+        std::cerr << "Could not find " << path << std::endl;
+        exit(1);
+    }
+    ResourceStream stream(file);
+    bool ret = tinyobj::LoadObj(&attrib, &shapes, &materials, &warn, &err, &stream);
 
     if (!warn.empty()) {
         std::cout << warn << std::endl;
@@ -37,35 +63,48 @@ inline std::pair<std::string, std::vector<Vertex>> loadOBJ(const char *path) {
         exit(1);
     }
 
-    for (unsigned int i = 0; i < shapes.size(); i++) {
-        for (auto index : shapes.at(i).mesh.indices) {
-            auto vertInd = index.vertex_index;
-            auto normInd = index.normal_index;
-            auto texInd = index.texcoord_index;
+    auto positionCount = static_cast<int>(attrib.vertices.size() / 3);
+    auto normalCount = static_cast<int>(attrib.normals.size() / 3);
+    auto textureCoordinateCount = static_cast<int>(attrib.texcoords.size() / 2);
+
+    std::unordered_map<ObjVertexKey, uint32_t, ObjVertexKeyHash> uniqueVertices;
+    for (const auto &shape : shapes) {
+        mesh.indices.reserve(mesh.indices.size() + shape.mesh.indices.size());
+        for (const auto &index : shape.mesh.indices) {
+            // the indices are checked once here rather than on every access, missing attributes are left at zero
+            if (index.vertex_index < 0 || index.vertex_index >= positionCount) {
+                std::cerr << "Invalid vertex index in " << path << std::endl;
+                exit(1);
+            }
+            ObjVertexKey key{index.vertex_index, index.normal_index < normalCount ? index.normal_index : -1,
+                             index.texcoord_index < textureCoordinateCount ? index.texcoord_index : -1};
 
-            auto vertex = Vertex{};
-            vertex.position = {attrib.vertices.at(3 * vertInd), attrib.vertices.at(3 * vertInd + 1),
-                               attrib.vertices.at(3 * vertInd + 2)};
-            vertex.normal = {attrib.normals.at(3 * normInd), attrib.normals.at(3 * normInd + 1),
-                             attrib.normals.at(3 * normInd + 2)};
-            vertex.textureCoordinate = {attrib.texcoords.at(2 * texInd), attrib.texcoords.at(2 * texInd + 1)};
-            verticesOut.emplace_back(vertex);
-            meshName = shapes.at(i).name;
+            auto inserted = uniqueVertices.insert({key, static_cast<uint32_t>(mesh.vertices.size())});
+            if (inserted.second) {
+                const float *position = &attrib.vertices[3 * key.position];
+                Vertex vertex{};
+                vertex.position = {position[0], position[1], position[2]};
+                if (key.normal >= 0) {
+                    const float *normal = &attrib.normals[3 * key.normal];
+                    vertex.normal = {normal[0], normal[1], normal[2]};
+                }
+                if (key.textureCoordinate >= 0) {
+                    const float *textureCoordinate = &attrib.texcoords[2 * key.textureCoordinate];
+                    vertex.textureCoordinate = {textureCoordinate[0], textureCoordinate[1]};
+                }
+                mesh.vertices.push_back(vertex);
+            }
+            mesh.indices.push_back(inserted.first->second);
         }
+        mesh.meshName = shape.name;
     }
-    return std::make_pair(meshName, std::move(verticesOut));
+    return mesh;
 }
 
 /** Generates a Mesh from a .obj file;
  *
- * @param filePath the path to the .obj file
+ * @param filePath the resource path of the .obj file
  */
 inline Mesh makeMeshFromFile(const std::string &filePath) {
-    std::pair<std::string, std::vector<Vertex>> meshData = loadOBJ(filePath.c_str());
-    Mesh outMesh;
-
-    outMesh.meshName = meshData.first;
-    outMesh.vertices = meshData.second;
-
-    return std::move(outMesh);
+    return loadOBJ(filePath.c_str());
 }
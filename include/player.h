@@ -27,13 +27,11 @@ public:
     /// Updates the player (movement physics and collision physics)
     void update(Engine *engine, float dt);
 
-    void draw(Shader &shader) override;
-
     /// Processes the player's inputs
     void processInput(Engine *engine);
 
-    /// Manipulates the camera's view based on the player's mouse input
-    void look(GLFWwindow *window, double xpos, double ypos);
+    /// Manipulates the camera's view based on the mouse movement of the current tick
+    void look(float deltaX, float deltaY);
 
     inline void setPosition(glm::vec3 position) {
         this->transform.setPosition(position);
@@ -0,0 +1,104 @@
+//
+// Created on 10/19/2026.
+//
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/// A timed zone, as recorded by a ProfileZone
+struct ProfileEvent {
+    const char *name;   // must be a string literal or otherwise outlive the profiler
+    uint64_t start;     // nanoseconds since the profiler started
+    uint64_t duration;  // nanoseconds
+};
+
+/** Collects timed zones from every thread and exports them as a Chrome trace (chrome://tracing, Perfetto). (singleton)
+ *
+ * Each thread records into its own fixed size ring buffer, so recording never locks and never allocates; once a
+ * buffer is full the oldest events of that thread are overwritten. Use the PROFILE_* macros rather than this class
+ * directly: they compile to nothing unless ENGINE_PROFILER is defined.
+ */
+class Profiler {
+public:
+    /// Number of events each thread keeps before overwriting its oldest ones
+    static constexpr size_t EVENTS_PER_THREAD = 1u << 16u;
+
+    /// Returns the current time in nanoseconds since the profiler started
+    static uint64_t now();
+
+    /// Records a zone on the calling thread's buffer
+    static void record(const char *name, uint64_t start, uint64_t end);
+
+    /// Names the calling thread in the trace
+    static void setThreadName(const std::string &name);
+
+    /** Writes the recorded events in Chrome's trace event JSON format
+     *
+     * @param path the file to write
+     * @return true if the file was written
+     */
+    static bool writeChromeTrace(const std::string &path);
+
+private:
+    struct ThreadBuffer {
+        std::string threadName;
+        unsigned int threadId = 0;
+        std::unique_ptr<ProfileEvent[]> events;
+        std::atomic<uint64_t> written{0};
+    };
+
+    Profiler();
+
+    Profiler(const Profiler &) = delete;
+
+    Profiler &operator=(const Profiler &) = delete;
+
+    static Profiler instance;
+
+    uint64_t epoch;
+    std::mutex buffersMutex;
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers{}; // kept alive after their thread exits
+
+    /// Returns the calling thread's buffer, creating it on first use
+    static ThreadBuffer &getThreadBuffer();
+};
+
+/// Times the enclosing scope and records it when it ends
+class ProfileZone {
+private:
+    const char *name;
+    uint64_t start;
+
+public:
+    explicit ProfileZone(const char *name) : name(name), start(Profiler::now()) {}
+
+    ~ProfileZone() { Profiler::record(name, start, Profiler::now()); }
+
+    ProfileZone(const ProfileZone &) = delete;
+
+    ProfileZone &operator=(const ProfileZone &) = delete;
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+#ifdef ENGINE_PROFILER
+/// Times the rest of the enclosing scope under the given name (a string literal)
+#define PROFILE_SCOPE(name) ProfileZone PROFILE_CONCAT(profileZone, __LINE__)(name)
+/// Times the rest of the enclosing function
+#define PROFILE_FUNCTION() PROFILE_SCOPE(__func__)
+/// Names the current thread in the trace
+#define PROFILE_THREAD_NAME(name) Profiler::setThreadName(name)
+/// Writes the trace recorded so far to the given file
+#define PROFILE_WRITE_TRACE(path) Profiler::writeChromeTrace(path)
+#else
+#define PROFILE_SCOPE(name) ((void) 0)
+#define PROFILE_FUNCTION() ((void) 0)
+#define PROFILE_THREAD_NAME(name) ((void) 0)
+#define PROFILE_WRITE_TRACE(path) ((void) 0)
+#endif
@@ -0,0 +1,12 @@
+//
+// Created on 10/19/2026.
+//
+#pragma once
+
+/// The render passes, executed in this order.
+enum RenderPass {
+    OPAQUE_PASS = 0,
+    SKY_PASS = 1,
+    TRANSLUCENT_PASS = 2,
+    RENDER_PASS_COUNT = 3
+};
@@ -0,0 +1,82 @@
+//
+// Created on 10/19/2026.
+//
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+#include "shader.h"
+#include "texture.h"
+#include "drawable.h"
+#include "render_pass.h"
+
+/// A single draw submitted to the RenderQueue. Pointers must stay valid until the queue is executed.
+struct DrawPacket {
+    uint64_t sortKey = 0;
+    Shader *shader = nullptr;
+    TextureInterface *texture = nullptr;
+    const Drawable *drawable = nullptr;
+    const glm::mat4 *modelMatrix = nullptr;
+    float opacity = 1.0f;
+};
+
+/** Collects the draws of a frame, sorts them by a 64-bit key and executes them with as few state changes as possible.
+ *
+ * Key layout, most significant bits first:
+ * <br/>opaque and sky passes: pass (4) | program (8) | texture (12) | vao (12) | depth (28), front to back.
+ * <br/>translucent pass: pass (4) | inverted depth (28) | program (8) | texture (12) | vao (12), back to front.
+ */
+class RenderQueue {
+private:
+    struct SortEntry {
+        uint64_t key;
+        uint32_t index;
+    };
+
+    std::vector<DrawPacket> packets{};
+    std::vector<SortEntry> sorted{};
+    std::vector<SortEntry> scratch{};
+
+    /// Sets the fixed function state (depth function, face culling) required by a pass
+    static void applyPassState(RenderPass pass);
+
+public:
+    /** Builds the sort key of a draw
+     *
+     * @param pass the render pass
+     * @param program the shader program ID
+     * @param texture the texture ID (0 if untextured)
+     * @param vao the vertex array ID
+     * @param viewDepth distance from the camera, clamped to the far plane
+     * @return the sort key
+     */
+    static uint64_t makeSortKey(RenderPass pass, GLuint program, GLuint texture, GLuint vao, float viewDepth);
+
+    /// Extracts the render pass from a sort key
+    static inline RenderPass getPassFromKey(uint64_t key) { return static_cast<RenderPass>(key >> 60u); }
+
+    /** Submits a draw to the queue
+     *
+     * @param pass the render pass to draw in
+     * @param shader the shader to draw with, its per-frame uniforms must already be set
+     * @param texture the texture to bind, or nullptr
+     * @param drawable the geometry to draw
+     * @param modelMatrix the model matrix to upload, or nullptr if the shader doesn't use one
+     * @param viewDepth the distance from the camera
+     * @param opacity the value of the shader's alpha uniform, only meaningful in the translucent pass
+     */
+    void submit(RenderPass pass, Shader &shader, TextureInterface *texture, const Drawable &drawable,
+                const glm::mat4 *modelMatrix, float viewDepth, float opacity = 1.0f);
+
+    /// Radix sorts the submitted draws by their key
+    void sort();
+
+    /// Issues the sorted draws. sort() must have been called since the last submit.
+    void execute();
+
+    /// Removes all draws, keeping the allocated storage for the next frame
+    void clear();
+
+    [[nodiscard]] inline size_t size() const { return packets.size(); }
+};
@@ -0,0 +1,87 @@
+//
+// Created on 10/19/2026.
+//
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include "render_pass.h"
+
+/// What the render path counts
+enum RenderCounter {
+    DRAW_CALLS = 0,      // glDraw* calls, a multi-draw counts once
+    DRAW_COMMANDS = 1,   // draws issued by those calls, i.e. the commands of a multi-draw
+    VERTICES = 2,        // vertices submitted, indices for indexed draws
+    TEXTURE_BINDS = 3,   // TextureInterface::bindTexture calls
+    SHADER_BINDS = 4,    // Shader::use calls
+    UNIFORM_UPDATES = 5, // Shader::set* calls
+    FRUSTUM_TESTS = 6,   // ViewFrustum::isBoxInFrustum calls
+    FRUSTUM_CULLED = 7,  // boxes found outside the frustum
+    RENDER_COUNTER_COUNT = 8
+};
+
+/// Slot of the counts made outside of RenderQueue::execute, i.e. while culling or setting up the frame's uniforms
+static constexpr unsigned int OUTSIDE_PASS = RENDER_PASS_COUNT;
+
+/// The render counters of one frame, per pass
+struct RenderCounters {
+    std::array<std::array<uint64_t, RENDER_COUNTER_COUNT>, RENDER_PASS_COUNT + 1> byPass{};
+
+    /// Returns a counter for a single pass, or OUTSIDE_PASS
+    [[nodiscard]] inline uint64_t get(RenderCounter counter, unsigned int pass) const { return byPass[pass][counter]; }
+
+    /// Returns a counter summed over the whole frame
+    [[nodiscard]] uint64_t get(RenderCounter counter) const {
+        uint64_t total = 0;
+        for (const auto &pass : byPass)
+            total += pass[counter];
+        return total;
+    }
+};
+
+/** Counts the draw calls, vertices, binds, uniform updates and frustum tests of each frame, per render pass.
+ * (singleton)
+ *
+ * Counting is a single addition, so it is always on; only the periodic log is optional. The render path runs on the
+ * main thread, so the counters aren't synchronized.
+ */
+class RenderStats {
+private:
+    RenderStats() = default;
+
+    RenderStats(const RenderStats &) = delete;
+
+    RenderStats &operator=(const RenderStats &) = delete;
+
+    static RenderStats instance;
+
+    RenderCounters currentFrame{};
+    RenderCounters lastFrame{};
+    unsigned int pass = OUTSIDE_PASS;
+    unsigned int logInterval = 0;
+    unsigned long long frameIndex = 0;
+
+    /// Logs the counters of the last frame
+    void logLastFrame() const;
+
+public:
+    /// Adds to a counter of the current pass
+    static inline void count(RenderCounter counter, uint64_t amount = 1) {
+        instance.currentFrame.byPass[instance.pass][counter] += amount;
+    }
+
+    /// Attributes the following counts to a pass, or to OUTSIDE_PASS
+    static inline void setPass(unsigned int renderPass) { instance.pass = renderPass; }
+
+    /// Marks the start of a new frame: the counters of the frame that just ended become available.
+    static void beginFrame();
+
+    /// Logs the counters of one frame every given number of frames, 0 to never log them
+    static void setLogInterval(unsigned int frames);
+
+    /// Returns the counters of the last complete frame
+    static const RenderCounters &getFrameCounters();
+
+    /// Returns the counters accumulated so far in the current frame
+    static const RenderCounters &getCurrentCounters();
+};
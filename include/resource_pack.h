@@ -0,0 +1,145 @@
+//
+// Created on 10/19/2026.
+//
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <istream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "mapped_file.h"
+
+/** The bytes of one resource: a view into the memory-mapped pack, or the content of a loose file, which it then owns.
+ * Views into the pack stay valid until the program exits.
+ */
+class Resource {
+private:
+    std::string owned; // only used for loose files
+    std::string_view bytes;
+    bool found = false;
+
+public:
+    Resource() = default;
+
+    /// A resource inside the pack
+    explicit Resource(std::string_view packed) : bytes(packed), found(true) {}
+
+    /// A loose file's content
+    explicit Resource(std::string &&loose) : owned(std::move(loose)), bytes(owned), found(true) {}
+
+    Resource(Resource &&other) noexcept { *this = std::move(other); }
+
+    Resource &operator=(Resource &&other) noexcept;
+
+    Resource(const Resource &) = delete;
+
+    Resource &operator=(const Resource &) = delete;
+
+    /// False if the resource doesn't exist
+    [[nodiscard]] inline bool isValid() const { return found; }
+
+    [[nodiscard]] inline const char *getData() const { return bytes.data(); }
+
+    [[nodiscard]] inline size_t getSize() const { return bytes.size(); }
+
+    [[nodiscard]] inline std::string_view view() const { return bytes; }
+};
+
+/// Reads a Resource through a std::istream, without copying it
+class ResourceStream : public std::istream {
+private:
+    class Buffer : public std::streambuf {
+    public:
+        Buffer(const char *data, size_t size) {
+            char *begin = const_cast<char *>(data);
+            setg(begin, begin, begin + size);
+        }
+    };
+
+    Buffer buffer;
+
+public:
+    explicit ResourceStream(const Resource &resource)
+            : std::istream(nullptr), buffer(resource.getData(), resource.getSize()) { rdbuf(&buffer); }
+};
+
+/** Gives access to the game's resources, from a single packed archive when there is one, otherwise from the loose
+ * resources/ folder. (singleton)
+ *
+ * The archive, resources.pack (made by tools/pack_resources.py), is memory-mapped whole at startup, so loading
+ * resources opens no other file and copies nothing: loaders get views into the mapping. Resources are named by their
+ * path inside resources/, with '/' separators, i.e. "textures/dirt.png". Both the archive and the folder are looked
+ * for in the working directory first, then next to the executable.
+ *
+ * Layout of the archive (little-endian):
+ *  - header: "RPAK", uint32 version, uint32 entry count, 4 bytes of padding
+ *  - one entry per file, sorted by path: uint64 data offset, uint64 data size, uint32 path offset, uint32 path length
+ *  - the paths, then the data of every file, each aligned to 16 bytes
+ */
+class ResourcePack {
+public:
+    ~ResourcePack();
+
+    /** Opens the archive, or finds the loose resources folder. Must be called before any resource is loaded.
+     *
+     * @param executablePath argv[0], to look for the resources next to the executable
+     * @return false if neither the archive nor the folder could be found
+     */
+    static bool init(const char *executablePath);
+
+    /// True when the resources come from the archive rather than loose files
+    [[nodiscard]] static bool isPacked();
+
+    /** Loads a resource
+     *
+     * @param path the path of the resource inside resources/, i.e. "models/cube.obj"
+     * @return the resource, check isValid() to know if it exists
+     */
+    static Resource load(const std::string &path);
+
+    /** Lists the files of a resource folder
+     *
+     * @param folder the folder inside resources/, i.e. "blocks"
+     * @return the names of the files directly in that folder, sorted
+     */
+    static std::vector<std::string> list(const std::string &folder);
+
+    /** Identifies the current version of a resource, to tell if something made from it is outdated
+     *
+     * @param path the path of the resource inside resources/
+     * @param size set to its size in bytes
+     * @param time set to the modification time of its file (the archive's, when packed)
+     * @return false if the resource doesn't exist
+     */
+    static bool describe(const std::string &path, uint64_t &size, int64_t &time);
+
+    /** Returns the file a resource is read from when the resources aren't packed, for loaders that read it
+     * themselves, i.e. to stream it
+     *
+     * @param path the path of the resource inside resources/
+     * @return empty when packed
+     */
+    static std::string getLoosePath(const std::string &path);
+
+private:
+    ResourcePack() = default;
+
+    ResourcePack(const ResourcePack &) = delete;
+
+    ResourcePack &operator=(const ResourcePack &) = delete;
+
+    static ResourcePack instance;
+
+    std::unique_ptr<MappedFile> pack;
+    int64_t packTime = 0; // modification time of the archive
+    std::unordered_map<std::string_view, std::string_view> entries; // path => data, both inside the mapping
+    std::vector<std::string_view> paths;                           // sorted
+    std::filesystem::path looseRoot;                               // the resources folder, when not packed
+
+    /// Maps the archive and reads its index, false if it isn't a valid archive
+    bool openPack(const std::filesystem::path &path);
+};
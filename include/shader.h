@@ -5,162 +5,205 @@
 #include <glm/glm.hpp>
 
 #include <string>
-#include <fstream>
-#include <sstream>
 #include <iostream>
+#include "gl_state.h"
+#include "render_stats.h"
+#include "resource_pack.h"
 
 class Shader
 {
 public:
     unsigned int ID;
-    // constructor generates the shader on the fly
+    // constructor generates the shader on the fly. With waitForLink false, the compile and link are only issued and
+    // finish() must be called before the first use: in the meantime a driver with KHR/ARB_parallel_shader_compile
+    // builds the program on its own threads (see enableParallelCompile)
     // ------------------------------------------------------------------------
-    Shader(const char* vertexPath, const char* fragmentPath, const char* geometryPath = nullptr)
+    Shader(const char* vertexPath, const char* fragmentPath, const char* geometryPath = nullptr,
+           bool waitForLink = true)
     {
-        // 1. retrieve the vertex/fragment source code from filePath
-        std::string vertexCode;
-        std::string fragmentCode;
+        // 1. retrieve the vertex/fragment source code from the resources (paths like "shaders/X.glsl")
+        Resource vShaderFile = ResourcePack::load(vertexPath);
+        Resource fShaderFile = ResourcePack::load(fragmentPath);
+        if (!vShaderFile.isValid() || !fShaderFile.isValid())
+            std::cout << "ERROR::SHADER::FILE_NOT_SUCCESFULLY_READ" << std::endl;
+        std::string vertexCode(vShaderFile.view());
+        std::string fragmentCode(fShaderFile.view());
         std::string geometryCode;
-        std::ifstream vShaderFile;
-        std::ifstream fShaderFile;
-        std::ifstream gShaderFile;
-        // ensure ifstream objects can throw exceptions:
-        vShaderFile.exceptions (std::ifstream::failbit | std::ifstream::badbit);
-        fShaderFile.exceptions (std::ifstream::failbit | std::ifstream::badbit);
-        gShaderFile.exceptions (std::ifstream::failbit | std::ifstream::badbit);
-        try
+        // if geometry shader path is present, also load a geometry shader
+        if(geometryPath != nullptr)
         {
-            // open files
-            vShaderFile.open(vertexPath);
-            fShaderFile.open(fragmentPath);
-            std::stringstream vShaderStream, fShaderStream;
-            // read file's buffer contents into streams
-            vShaderStream << vShaderFile.rdbuf();
-            fShaderStream << fShaderFile.rdbuf();
-            // close file handlers
-            vShaderFile.close();
-            fShaderFile.close();
-            // convert stream into string
-            vertexCode = vShaderStream.str();
-            fragmentCode = fShaderStream.str();
-            // if geometry shader path is present, also load a geometry shader
-            if(geometryPath != nullptr)
-            {
-                gShaderFile.open(geometryPath);
-                std::stringstream gShaderStream;
-                gShaderStream << gShaderFile.rdbuf();
-                gShaderFile.close();
-                geometryCode = gShaderStream.str();
-            }
-        }
-        catch (std::ifstream::failure &) {
-            std::cout << "ERROR::SHADER::FILE_NOT_SUCCESFULLY_READ" << std::endl;
+            Resource gShaderFile = ResourcePack::load(geometryPath);
+            if (!gShaderFile.isValid())
+                std::cout << "ERROR::SHADER::FILE_NOT_SUCCESFULLY_READ" << std::endl;
+            geometryCode = std::string(gShaderFile.view());
         }
         const char* vShaderCode = vertexCode.c_str();
         const char * fShaderCode = fragmentCode.c_str();
-        // 2. compile shaders
-        unsigned int vertex, fragment;
+        // 2. compile shaders, their status is only queried by finish() as querying it waits for the compile
         // vertex shader
         vertex = glCreateShader(GL_VERTEX_SHADER);
         glShaderSource(vertex, 1, &vShaderCode, NULL);
         glCompileShader(vertex);
-        checkCompileErrors(vertex, "VERTEX");
         // fragment Shader
         fragment = glCreateShader(GL_FRAGMENT_SHADER);
         glShaderSource(fragment, 1, &fShaderCode, NULL);
         glCompileShader(fragment);
-        checkCompileErrors(fragment, "FRAGMENT");
         // if geometry shader is given, compile geometry shader
-        unsigned int geometry;
         if(geometryPath != nullptr)
         {
             const char * gShaderCode = geometryCode.c_str();
             geometry = glCreateShader(GL_GEOMETRY_SHADER);
             glShaderSource(geometry, 1, &gShaderCode, NULL);
             glCompileShader(geometry);
-            checkCompileErrors(geometry, "GEOMETRY");
         }
         // shader Program
         ID = glCreateProgram();
         glAttachShader(ID, vertex);
         glAttachShader(ID, fragment);
-        if(geometryPath != nullptr)
+        if(geometry != 0)
             glAttachShader(ID, geometry);
         glLinkProgram(ID);
+        pending = true;
+        if (waitForLink)
+            finish();
+    }
+    // waits for the program to be linked and checks it for errors, does nothing once it's done
+    // ------------------------------------------------------------------------
+    void finish()
+    {
+        if (!pending)
+            return;
+        checkCompileErrors(vertex, "VERTEX");
+        checkCompileErrors(fragment, "FRAGMENT");
+        if(geometry != 0)
+            checkCompileErrors(geometry, "GEOMETRY");
         checkCompileErrors(ID, "PROGRAM");
         // delete the shaders as they're linked into our program now and no longer necessery
         glDeleteShader(vertex);
         glDeleteShader(fragment);
-        if(geometryPath != nullptr)
+        if(geometry != 0)
             glDeleteShader(geometry);
-
+        pending = false;
+    }
+    // true if finish() wouldn't wait. Only known with parallel shader compile, without it this is false until finish()
+    // ------------------------------------------------------------------------
+    bool isReady() const
+    {
+        if (!pending)
+            return true;
+        if (!parallelCompile)
+            return false;
+        GLint complete = GL_FALSE;
+        glGetProgramiv(ID, COMPLETION_STATUS, &complete);
+        return complete == GL_TRUE;
+    }
+    // lets the driver compile and link on as many threads as it likes, returns false if it doesn't support it.
+    // Called once, after glewInit
+    // ------------------------------------------------------------------------
+    static bool enableParallelCompile()
+    {
+#ifdef GL_KHR_parallel_shader_compile
+        if (GLEW_KHR_parallel_shader_compile)
+        {
+            glMaxShaderCompilerThreadsKHR(0xFFFFFFFF);
+            parallelCompile = true;
+        }
+#endif
+#ifdef GL_ARB_parallel_shader_compile
+        if (!parallelCompile && GLEW_ARB_parallel_shader_compile)
+        {
+            glMaxShaderCompilerThreadsARB(0xFFFFFFFF);
+            parallelCompile = true;
+        }
+#endif
+        return parallelCompile;
     }
     // activate the shader
     // ------------------------------------------------------------------------
     void use()
     {
-        glUseProgram(ID);
+        GLStateCache::useProgram(ID);
+        RenderStats::count(SHADER_BINDS);
     }
     // utility uniform functions
     // ------------------------------------------------------------------------
     void setBool(const std::string &name, bool value) const
     {
         glUniform1i(glGetUniformLocation(ID, name.c_str()), (int)value);
+        RenderStats::count(UNIFORM_UPDATES);
     }
     // ------------------------------------------------------------------------
     void setInt(const std::string &name, int value) const
     {
         glUniform1i(glGetUniformLocation(ID, name.c_str()), value);
+        RenderStats::count(UNIFORM_UPDATES);
     }
     // ------------------------------------------------------------------------
     void setFloat(const std::string &name, float value) const
     {
         glUniform1f(glGetUniformLocation(ID, name.c_str()), value);
+        RenderStats::count(UNIFORM_UPDATES);
     }
     // ------------------------------------------------------------------------
     void setVec2(const std::string &name, const glm::vec2 &value) const
     {
         glUniform2fv(glGetUniformLocation(ID, name.c_str()), 1, &value[0]);
+        RenderStats::count(UNIFORM_UPDATES);
     }
     void setVec2(const std::string &name, float x, float y) const
     {
         glUniform2f(glGetUniformLocation(ID, name.c_str()), x, y);
+        RenderStats::count(UNIFORM_UPDATES);
     }
     // ------------------------------------------------------------------------
     void setVec3(const std::string &name, const glm::vec3 &value) const
     {
         glUniform3fv(glGetUniformLocation(ID, name.c_str()), 1, &value[0]);
+        RenderStats::count(UNIFORM_UPDATES);
     }
     void setVec3(const std::string &name, float x, float y, float z) const
     {
         glUniform3f(glGetUniformLocation(ID, name.c_str()), x, y, z);
+        RenderStats::count(UNIFORM_UPDATES);
     }
     // ------------------------------------------------------------------------
     void setVec4(const std::string &name, const glm::vec4 &value) const
     {
         glUniform4fv(glGetUniformLocation(ID, name.c_str()), 1, &value[0]);
+        RenderStats::count(UNIFORM_UPDATES);
     }
     void setVec4(const std::string &name, float x, float y, float z, float w)
     {
         glUniform4f(glGetUniformLocation(ID, name.c_str()), x, y, z, w);
+        RenderStats::count(UNIFORM_UPDATES);
     }
     // ------------------------------------------------------------------------
     void setMat2(const std::string &name, const glm::mat2 &mat) const
     {
         glUniformMatrix2fv(glGetUniformLocation(ID, name.c_str()), 1, GL_FALSE, &mat[0][0]);
+        RenderStats::count(UNIFORM_UPDATES);
     }
     // ------------------------------------------------------------------------
     void setMat3(const std::string &name, const glm::mat3 &mat) const
     {
         glUniformMatrix3fv(glGetUniformLocation(ID, name.c_str()), 1, GL_FALSE, &mat[0][0]);
+        RenderStats::count(UNIFORM_UPDATES);
     }
     // ------------------------------------------------------------------------
     void setMat4(const std::string &name, const glm::mat4 &mat) const
     {
         glUniformMatrix4fv(glGetUniformLocation(ID, name.c_str()), 1, GL_FALSE, &mat[0][0]);
+        RenderStats::count(UNIFORM_UPDATES);
     }
 
 private:
+    // GL_COMPLETION_STATUS_KHR, which has the same value as the ARB's
+    static constexpr GLenum COMPLETION_STATUS = 0x91B1;
+    static inline bool parallelCompile = false;
+
+    unsigned int vertex = 0, fragment = 0, geometry = 0;
+    bool pending = false; // linked but not checked yet
+
     // utility function for checking shader compilation/linking errors.
     // ------------------------------------------------------------------------
     void checkCompileErrors(GLuint shader, std::string type)
@@ -10,6 +10,8 @@
 #include <optional>
 #include "../libs/easylogging++.h"
 #include "../libs/irrKLang/include/irrKlang.h"
+#include "asset_residency.h"
+#include "engine_constants.h"
 
 #if defined(__unix__) || _MSC_VER >= 1914
 namespace fs = std::filesystem;
@@ -17,7 +19,21 @@ namespace fs = std::filesystem;
 namespace fs = std::filesystem;
 #endif
 
-/// The SoundDatabase holds all the processed sound files that can be used at runtime. (singleton)
+/// How the sound engine holds a sound, chosen from the size of its file
+enum SoundKind {
+    SOUND_EFFECT, // decoded whole by init, so that playing it never waits for the decoder
+    SOUND_MUSIC   // streamed: decoded in chunks on irrKlang's thread as it plays, from the file or the mapped pack
+};
+
+/** The SoundDatabase holds all the processed sound files that can be used at runtime. (singleton)
+ *
+ * Files smaller than EngineConstants::SOUND_STREAMING_THRESHOLD, i.e. pop.mp3 and the place-block sounds, are effects
+ * and the larger ones music, so that the decoded audio held in memory doesn't grow with the length of the tracks.
+ *
+ * The effects are always registered and decoded by init, since decoding one takes long enough to stall a frame. The
+ * music is registered by init too, unless lazy: a track is then only registered the first time it is played, which
+ * decodes nothing on the calling thread. Tracks hold no decoded samples, so they aren't evicted.
+ */
 class SoundDatabase {
 private:
     SoundDatabase();
@@ -27,14 +43,32 @@ private:
     SoundDatabase &operator=(const SoundDatabase &) = delete;
 
     static SoundDatabase instance;
-    std::unordered_map<std::string, std::shared_ptr<irrklang::ISoundSource>> sounds{};
+    std::unordered_map<std::string, size_t> soundIndices{}; // name => index
+    std::vector<std::string> names;
+    std::vector<SoundKind> kinds;
+    std::vector<std::shared_ptr<irrklang::ISoundSource>> sounds; // owned by the engine, empty while not registered
     std::unique_ptr<irrklang::ISoundEngine> soundEngine;
 
+    bool lazy = false;
+    AssetResidency residency; // indexed like the sounds, when lazy
+
+    /// Registers a sound with the sound engine according to its kind, false if it couldn't be
+    bool registerSound(size_t index);
+
+    /// The decoded bytes a registered sound keeps in memory, 0 for a stream
+    [[nodiscard]] static int64_t getDecodedBytes(irrklang::ISoundSource *source);
+
+    /// The registered sound of a name, registering a lazy music track first. Empty if there is no such sound.
+    std::shared_ptr<irrklang::ISoundSource> findSound(const std::string &name);
+
 public:
     ~SoundDatabase();
 
-    /// Initializes the database, should only be called once at the start of the application.
-    static void init();
+    /** Initializes the database, should only be called once at the start of the application.
+     *
+     * @param lazy only register the music tracks when they're first played, see the class
+     */
+    static void init(bool lazy = false);
 
     /** Plays a sound by it's given name.
      *
@@ -49,4 +83,13 @@ public:
      * @return If found, returns the sound source, otherwise empty.
      */
     static std::optional<std::shared_ptr<irrklang::ISoundSource>> getSoundSourceByName(const std::string &name);
+
+    /// Ends the frame of the lazily registered sounds, when lazy. Called once per frame.
+    static void update();
+
+    /// Loads and decoded bytes of the sounds, when lazy
+    [[nodiscard]] static AssetResidencyStats getResidencyStats();
+
+    /// Measures the decoded samples held by the sound sources and stores them in MemoryStats (SOUNDS)
+    static void measureMemory();
 };
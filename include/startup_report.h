@@ -0,0 +1,78 @@
+//
+// Created on 10/19/2026.
+//
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+/// A timed step of the startup
+struct StartupStageTiming {
+    std::string name;
+    double startMs;    // since StartupReport::begin
+    double durationMs;
+};
+
+/** Times the stages of the startup and the time to the first presented frame, and writes them as JSON. (singleton)
+ *
+ * Stages are timed with a StartupStage in the scope they cover. Stages can nest (the report lists them in the order
+ * they ended), so their durations don't necessarily add up to the time to the first frame.
+ */
+class StartupReport {
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    StartupReport() = default;
+
+    StartupReport(const StartupReport &) = delete;
+
+    StartupReport &operator=(const StartupReport &) = delete;
+
+    static StartupReport instance;
+
+    Clock::time_point start = Clock::now();
+    std::vector<StartupStageTiming> stages{};
+    double firstFrameMs = -1.0;
+
+public:
+    /// Starts the clock, to be called first thing in main (otherwise it starts when the program is loaded)
+    static void begin();
+
+    /// Returns the milliseconds since begin
+    static double elapsedMs();
+
+    /// Adds a timed stage
+    static void addStage(const std::string &name, double startMs, double durationMs);
+
+    /// Records the time to the first presented frame, only the first call counts
+    static void markFirstFrame();
+
+    [[nodiscard]] static bool hasFirstFrame();
+
+    /// Logs the stages and the time to the first frame
+    static void logSummary();
+
+    /** Writes the stages and the time to the first frame as JSON
+     *
+     * @param path the file to write
+     * @return true if the file was written
+     */
+    static bool write(const std::string &path);
+};
+
+/// Times the rest of the enclosing scope as a startup stage
+class StartupStage {
+private:
+    const char *name;
+    double startMs;
+
+public:
+    explicit StartupStage(const char *name) : name(name), startMs(StartupReport::elapsedMs()) {}
+
+    ~StartupStage() { StartupReport::addStage(name, startMs, StartupReport::elapsedMs() - startMs); }
+
+    StartupStage(const StartupStage &) = delete;
+
+    StartupStage &operator=(const StartupStage &) = delete;
+};
@@ -8,6 +8,8 @@
 #include <iostream>
 #include <vector>
 #include "../libs/stb_image.h"
+#include "gl_state.h"
+#include "memory_stats.h"
 
 /// The types of textures supported.
 enum TextureType {
@@ -16,18 +18,130 @@ enum TextureType {
     CUBEMAP
 };
 
+/** A decoded image file, waiting to be uploaded. Owns its pixels, which are counted as TEXTURE_STAGING until the image
+ * is destroyed. Decoding doesn't touch OpenGL, so images can be decoded on any thread.
+ */
+class DecodedImage {
+private:
+    unsigned char *pixels = nullptr;
+    int width = 0, height = 0, channels = 0;
+
+public:
+    DecodedImage() = default;
+
+    /// Decodes an image file, check isValid() to know if it succeeded
+    explicit DecodedImage(const std::string &filePath);
+
+    ~DecodedImage();
+
+    DecodedImage(DecodedImage &&other) noexcept;
+
+    DecodedImage &operator=(DecodedImage &&other) noexcept;
+
+    DecodedImage(const DecodedImage &) = delete;
+
+    DecodedImage &operator=(const DecodedImage &) = delete;
+
+    [[nodiscard]] inline bool isValid() const { return pixels != nullptr; }
+
+    [[nodiscard]] inline const unsigned char *getPixels() const { return pixels; }
+
+    [[nodiscard]] inline int getWidth() const { return width; }
+
+    [[nodiscard]] inline int getHeight() const { return height; }
+
+    [[nodiscard]] inline int getChannels() const { return channels; }
+
+    /// Size in bytes of the pixels, which is also the size of the texture they're uploaded to (8 bits per channel)
+    [[nodiscard]] inline int64_t getBytes() const { return static_cast<int64_t>(width) * height * channels; }
+};
+
+/// One mip level of an image, with tightly packed rows
+struct ImageLevel {
+    int width = 0, height = 0;
+    std::vector<unsigned char> data;
+};
+
+/** An image and its whole mip chain, ready to be uploaded, either as RGB/RGBA pixels or block-compressed. Built from a
+ * DecodedImage on any thread, or read back from the TextureCache. Its levels are counted as TEXTURE_STAGING until the
+ * image is destroyed.
+ */
+class MipmappedImage {
+private:
+    GLenum format = 0;         // GL_RGB or GL_RGBA
+    GLenum internalFormat = 0; // the format of the texture: format itself, or the compressed format of the levels
+    std::vector<ImageLevel> levels;
+
+public:
+    MipmappedImage() = default;
+
+    /** Builds the mip chain of a decoded image, down to 1x1, with a box filter. Grey images are expanded to RGB(A) so
+     * they don't end up in the red channel.
+     */
+    explicit MipmappedImage(const DecodedImage &image);
+
+    /// Takes levels built beforehand, i.e. read from the cache
+    MipmappedImage(GLenum format, GLenum internalFormat, std::vector<ImageLevel> &&levels);
+
+    ~MipmappedImage();
+
+    MipmappedImage(MipmappedImage &&other) noexcept;
+
+    MipmappedImage &operator=(MipmappedImage &&other) noexcept;
+
+    MipmappedImage(const MipmappedImage &) = delete;
+
+    MipmappedImage &operator=(const MipmappedImage &) = delete;
+
+    /// Replaces the levels with their block-compressed version
+    void setCompressedLevels(GLenum compressedFormat, std::vector<ImageLevel> &&compressedLevels);
+
+    [[nodiscard]] inline bool isValid() const { return !levels.empty(); }
+
+    [[nodiscard]] inline bool isCompressed() const { return internalFormat != format; }
+
+    /// The GL format of uncompressed levels, GL_RGB or GL_RGBA
+    [[nodiscard]] inline GLenum getFormat() const { return format; }
+
+    [[nodiscard]] inline GLenum getInternalFormat() const { return internalFormat; }
+
+    [[nodiscard]] inline const std::vector<ImageLevel> &getLevels() const { return levels; }
+
+    /// Size in bytes of all the levels, which is also the size of the texture they're uploaded to
+    [[nodiscard]] int64_t getBytes() const;
+
+    /** Uploads every level to the currently bound texture
+     *
+     * @param target the texture target, i.e. GL_TEXTURE_2D or a cube map face
+     */
+    void upload(GLenum target) const;
+};
+
 /// An interface for Texture classes
 class TextureInterface {
 private:
     static const TextureType texTypeBase = ABSTRACT;
 protected:
     GLuint texID;
+    int64_t gpuBytes = 0; // estimated size of the uploaded texture
+
+    /// Counts the uploaded texture in MemoryStats, until it is destroyed
+    inline void trackGpuBytes(int64_t bytes) {
+        gpuBytes = bytes;
+        MemoryStats::add(TEXTURES_GPU, bytes);
+    }
 
 public:
 
     virtual ~TextureInterface() = default;
 
-    virtual void destroyTexture() { glDeleteTextures(1, &texID); }
+    virtual void destroyTexture() {
+        glDeleteTextures(1, &texID);
+        GLStateCache::forgetTexture(texID);
+        if (gpuBytes > 0)
+            MemoryStats::remove(TEXTURES_GPU, gpuBytes);
+        gpuBytes = 0;
+    }
 
     /** Loads a texture from a single file
      *
@@ -49,6 +163,9 @@ public:
 
     inline GLuint getTexId() { return texID; }
 
+    /// Estimated size of the uploaded texture, 0 if there is none
+    [[nodiscard]] inline int64_t getGpuBytes() const { return gpuBytes; }
+
     inline void setTexId(GLuint id) { this->texID = id; }
 };
 
@@ -61,6 +178,12 @@ public:
 
     Texture2D(const std::string &filePath);
 
+    /// Creates the texture from an image prepared beforehand
+    explicit Texture2D(const MipmappedImage &image);
+
+    /// Uploads an image and its mip levels to a new texture
+    void upload(const MipmappedImage &image);
+
     void loadFromFile(const std::string &filePaths) override;
 
     void loadFromFaceFiles(const std::vector<std::string> &filePaths) override;
@@ -79,6 +202,18 @@ public:
 
     CubeMap(const std::vector<std::string> &filePaths);
 
+    /// Creates the cube map from images prepared beforehand, see upload()
+    explicit CubeMap(const std::vector<MipmappedImage> &faces);
+
+    /** Uploads images and their mip levels to a new cube map
+     *
+     * @param faces six images in the order of the GL_TEXTURE_CUBE_MAP_* faces, or a single one used for all of them
+     */
+    void upload(const std::vector<MipmappedImage> &faces);
+
+    /// Same as above, for faces that share images with each other or with other textures
+    void upload(const std::vector<const MipmappedImage *> &faces);
+
     void loadFromFile(const std::string &filePaths) override;
 
     void loadFromFaceFiles(const std::vector<std::string> &filePaths) override;
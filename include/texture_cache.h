@@ -0,0 +1,46 @@
+//
+// Created on 10/19/2026.
+//
+#pragma once
+
+#include <string>
+#include "texture.h"
+
+/** Keeps the mipmapped, and when possible block-compressed, version of every texture file on disk, so it doesn't have
+ * to be decoded and mipmapped at each launch. (static)
+ *
+ * Each source image gets a file in EngineConstants::TEXTURE_CACHE_DIR holding its levels, along with the size and
+ * modification time of the source, so an edited image is baked again. Images are compressed by the driver, to BC1
+ * (DXT1) for RGB and BC3 (DXT5) for RGBA, when EXT_texture_compression_s3tc is supported; otherwise the levels are
+ * cached uncompressed. Delete the folder to bake everything again.
+ */
+class TextureCache {
+public:
+    TextureCache() = delete;
+
+    /** Reads the cached version of an image. Can be called from any thread.
+     *
+     * @param sourcePath the image file the cache entry was baked from
+     * @param image set to the cached levels
+     * @return false if there is no usable entry: missing, outdated, or compressed in a format the context lacks
+     */
+    static bool load(const std::string &sourcePath, MipmappedImage &image);
+
+    /** Writes the cache entry of an image. Can be called from any thread.
+     *
+     * @param sourcePath the image file the levels were baked from
+     * @param image the levels to cache
+     * @return true if the entry was written
+     */
+    static bool store(const std::string &sourcePath, const MipmappedImage &image);
+
+    /** Block-compresses the levels of an image with the driver's encoder. Must be called from the thread that owns the
+     * OpenGL context.
+     *
+     * @return false if the image was left as it was, i.e. compression isn't supported
+     */
+    static bool compress(MipmappedImage &image);
+
+    /// Whether the context can use (and encode) the compressed formats of the cache
+    [[nodiscard]] static bool isCompressionSupported();
+};
@@ -8,8 +8,11 @@
 #include <filesystem>
 #include <unordered_map>
 #include "../libs/easylogging++.h"
-#include "block.h"
+#include "asset_residency.h"
+#include "block_registry.h"
+#include "engine_constants.h"
 #include "texture.h"
+#include "job_system.h"
 
 #ifdef __unix__
 namespace fs = std::filesystem;
@@ -21,7 +24,14 @@ namespace fs = std::filesystem;
 namespace fs = std::filesystem;
 #endif
 
-/// The Texture Database loads available textures according to the defined blocks and stores them for easy access.
+/** The Texture Database loads available textures according to the defined blocks and stores them for easy access.
+ *
+ * By default every texture is loaded by init. When lazy, a texture is only loaded the first time it is asked for: its
+ * images are decoded on the job system and uploaded by a main thread job, and until then the texture object shows a
+ * grey placeholder. Textures not used for a frame are evicted, least recently used first, once the resident ones take
+ * more than EngineConstants::TEXTURE_RESIDENCY_BUDGET, and loaded again if they're needed later. The texture objects
+ * themselves stay the same, only the GL texture behind them changes.
+ */
 class TextureDatabase {
 private:
     TextureDatabase();
@@ -31,19 +41,52 @@ private:
     TextureDatabase &operator=(const TextureDatabase &) = delete;
 
     static TextureDatabase instance;
-    std::unordered_map<BlockID, std::shared_ptr<TextureInterface>> textures;
+    std::array<std::shared_ptr<TextureInterface>, BLOCK_ID_COUNT> textures{}; // indexed by BlockID
+
+    bool lazy = false;
+    JobSystem *jobs = nullptr;
+    AssetResidency residency{EngineConstants::TEXTURE_RESIDENCY_BUDGET}; // indexed by BlockID, when lazy
+    std::shared_ptr<Texture2D> placeholder2D;
+    std::shared_ptr<CubeMap> placeholderCubeMap;
+
+    /// Loads every texture at once
+    void loadAll();
+
+    /// Creates the placeholders and a texture object showing them for every block
+    void createPlaceholders();
+
+    /// Starts loading the texture of a block in the background, when lazy
+    void requestLoad(BlockID id);
+
+    /// The GL texture a block's texture shows while it isn't resident
+    GLuint getPlaceholderId(BlockID id) const;
 
 public:
 
     ~TextureDatabase();
 
-    /// Initializes the texture database. Should only be called once during program execution.
-    static void init();
+    /** Initializes the texture database from the textures of the BlockRegistry's blocks. Should only be called once
+     * during program execution, from the thread that owns the OpenGL context.
+     *
+     * @param jobs decodes the images on its workers; the textures are then uploaded together on the calling thread
+     * @param lazy only load the textures when they're first used, see the class
+     */
+    static void init(JobSystem &jobs, bool lazy = false);
 
-    /** Returns a texture based on the block ID provided.
+    /** Returns a texture based on the block ID provided. When lazy, this counts as a use of the texture and starts
+     * loading it if it isn't resident, so it must be called from the main thread.
      *
      * @param id the block to fetch a texture for.
      * @return NULL if blockId is not registered. Otherwise returns a pointer to a texture.
      */
     static std::shared_ptr<TextureInterface> &getTextureByBlockId(BlockID id);
+
+    /// Evicts the least recently used textures over the budget, when lazy. Called once per frame, after drawing.
+    static void update();
+
+    /// Frees the textures and the placeholders. Called before the context is destroyed, from the thread that owns it.
+    static void destroy();
+
+    /// Loads, evictions and resident bytes of the lazily loaded textures
+    [[nodiscard]] static AssetResidencyStats getResidencyStats();
 };
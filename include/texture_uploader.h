@@ -0,0 +1,89 @@
+//
+// Created on 10/19/2026.
+//
+#pragma once
+
+#include <GL/glew.h>
+#include <array>
+
+/// Counters of the TextureUploader since it was created
+struct TextureUploaderStats {
+    unsigned long long streamedUploads = 0;   // went through the ring
+    unsigned long long directUploads = 0;     // copied from client memory, i.e. too big for a segment or no ring
+    unsigned long long streamedBytes = 0;
+    unsigned long long stalls = 0;            // times a segment was still being read by the GPU when it was reused
+};
+
+/** Streams texture uploads through a ring of persistently mapped pixel buffers. (singleton)
+ *
+ * The ring is one GL_PIXEL_UNPACK_BUFFER split into segments. Pixels are copied into the current segment and the
+ * glTexImage2D reads them from there, so the call returns without waiting for the transfer; when the segment is full
+ * it is fenced and the next one is used, waiting on its fence only if the GPU still hasn't read it. Without
+ * ARB_buffer_storage (GL 4.4), or for images bigger than a segment, uploads fall back to glTexImage2D from client
+ * memory. The ring is created on first use, on the thread that owns the context.
+ */
+class TextureUploader {
+public:
+    /// Size in bytes of each segment of the ring, the largest image that can be streamed
+    static constexpr GLsizeiptr SEGMENT_SIZE = 4 * 1024 * 1024;
+
+    /// Number of segments, i.e. how many batches of uploads can be in flight
+    static constexpr unsigned int SEGMENT_COUNT = 4;
+
+    /** Uploads the pixels of one image to the currently bound texture, like glTexImage2D
+     *
+     * @param target the texture target, i.e. GL_TEXTURE_2D or a cube map face
+     * @param level the mip level
+     * @param internalFormat the format of the texture, the driver converts the pixels to it
+     * @param width the width of the image
+     * @param height the height of the image
+     * @param format the format of the pixels, 8 bits per channel
+     * @param pixels the pixels, tightly packed, only read during the call
+     * @param size the size of the pixels in bytes
+     */
+    static void texImage2D(GLenum target, GLint level, GLenum internalFormat, GLsizei width, GLsizei height,
+                           GLenum format, const void *pixels, GLsizeiptr size);
+
+    /// Same as texImage2D, for block-compressed data, like glCompressedTexImage2D
+    static void compressedTexImage2D(GLenum target, GLint level, GLenum internalFormat, GLsizei width,
+                                     GLsizei height, const void *data, GLsizeiptr size);
+
+    /// Fences the uploads issued so far, so that the segment they're in can be reused. Called once per frame.
+    static void flush();
+
+    /// Deletes the ring, must be called while the context is still current
+    static void destroy();
+
+    [[nodiscard]] static TextureUploaderStats getStats();
+
+private:
+    TextureUploader() = default;
+
+    TextureUploader(const TextureUploader &) = delete;
+
+    TextureUploader &operator=(const TextureUploader &) = delete;
+
+    static TextureUploader instance;
+
+    bool initialized = false;
+    bool persistent = false; // false when the ring couldn't be created, everything goes the direct way
+    GLuint buffer = 0;
+    unsigned char *mapped = nullptr;
+    std::array<GLsync, SEGMENT_COUNT> fences{};
+    unsigned int segment = 0;
+    GLsizeiptr offset = 0; // inside the current segment
+    TextureUploaderStats stats{};
+
+    /// Creates and maps the ring, if the context supports it
+    void init();
+
+    /// Fences the current segment and moves to the next, waiting until the GPU is done reading it
+    void nextSegment();
+
+    /** Copies data into the ring and binds it as the unpack buffer, to be followed by the upload call
+     *
+     * @param start set to the offset of the data in the ring
+     * @return false if the data must be uploaded from client memory instead
+     */
+    bool stage(const void *data, GLsizeiptr size, GLintptr &start);
+};
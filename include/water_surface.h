@@ -0,0 +1,65 @@
+//
+// Created on 10/19/2026.
+//
+#pragma once
+
+#include <vector>
+#include <glm/glm.hpp>
+#include "mesh.h"
+
+/** The exposed water of a single chunk: the top faces of the water blocks that have air above them.
+ *
+ * The faces are baked into the chunk's mesh. The surface keeps track of their order so that they can be kept sorted
+ * back to front for blending, but only re-sorts them once the camera has moved far enough from the last sort.
+ */
+class WaterSurface {
+private:
+    std::vector<glm::vec3> faceCenters{};
+    std::vector<unsigned int> faceOrder{};
+    unsigned int firstVertex = 0;
+    glm::vec3 lastSortPosition{};
+    bool sorted = false;
+
+    /// Writes the triangles of the faces in their current order
+    void writeIndices(std::vector<unsigned int> &indices) const;
+
+public:
+    /// How far the camera needs to move (in blocks) before the faces are sorted again
+    static constexpr float RESORT_DISTANCE = 4.0f;
+
+    /// Height of the water surface inside its block, slightly lower than a full block
+    static constexpr float SURFACE_HEIGHT = 0.9f;
+
+    /// Alpha the water is blended with
+    static constexpr float OPACITY = 0.7f;
+
+    /** Appends the surface to a chunk mesh
+     *
+     * @param exposedBlocks world positions of the water blocks that have air above them
+     * @param vertices the chunk's vertices, the corners of the faces are appended
+     * @param indices the chunk's indices, the triangles of the faces are appended
+     */
+    void build(const std::vector<glm::vec3> &exposedBlocks, std::vector<ChunkVertex> &vertices,
+               std::vector<unsigned int> &indices);
+
+    /// Returns true if the camera moved far enough since the last sort that the faces need sorting again
+    [[nodiscard]] bool needsResort(const glm::vec3 &viewPos) const;
+
+    /** Sorts the faces back to front from the given position
+     *
+     * @param viewPos the camera position
+     * @param indices receives the triangles of the faces in their new order (6 indices per face)
+     */
+    void sortBackToFront(const glm::vec3 &viewPos, std::vector<unsigned int> &indices);
+
+    [[nodiscard]] inline unsigned int getIndexCount() const {
+        return static_cast<unsigned int>(faceCenters.size() * 6);
+    }
+
+    [[nodiscard]] inline bool isEmpty() const { return faceCenters.empty(); }
+
+    /// Bytes used to keep track of the faces
+    [[nodiscard]] inline size_t getCpuBytes() const {
+        return faceCenters.capacity() * sizeof(glm::vec3) + faceOrder.capacity() * sizeof(unsigned int);
+    }
+};
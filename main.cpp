@@ -5,7 +5,12 @@
 #include <iostream>
 #include <filesystem>
 #include "libs/easylogging++.h"
+#include "include/block_registry.h"
 #include "include/engine.h"
+#include "include/logging.h"
+#include "include/profiler.h"
+#include "include/resource_pack.h"
+#include "include/startup_report.h"
 
 INITIALIZE_EASYLOGGINGPP
 
@@ -21,32 +26,71 @@ namespace fs = std::filesystem;
 
 void initLogging();
 Config cliConfig();
+bool argsConfig(int argc, char *argv[], Config &conf);
 
 /// Main
 int main(int argc, char *argv[]) {
 
+    StartupReport::begin();
     initLogging();
+    PROFILE_THREAD_NAME("Main");
+    if (!ResourcePack::init(argv[0]))
+        return 1;
+    BlockRegistry::init();
+
+    // the interactive prompts are only used when no flags are given
+    Config config{};
+    if (argc > 1) {
+        if (!argsConfig(argc, argv, config))
+            return 1;
+    } else {
+        config = cliConfig();
+    }
 
-    auto config = cliConfig();
-
+    double engineStart = StartupReport::elapsedMs();
     auto engine = Engine(config);
+    StartupReport::addStage("engine", engineStart, StartupReport::elapsedMs() - engineStart);
+    engine.startShaders();
+    if (!config.replayPath.empty() && !engine.getInput().isReplaying())
+        return 1;
+    // a replay changes the config to the recorded session's
+    config = engine.getConfig();
 
     LOG(INFO) << "Initializing resource databases.";
 
-    TextureDatabase::init();
-    ModelDatabase::init();
-    SoundDatabase::init();
+    // textures and models are uploaded as soon as they're loaded, so they need the OpenGL context
+    if (engine.hasGLContext()) {
+        {
+            StartupStage stage("textureDatabase");
+            TextureDatabase::init(engine.getJobSystem(), config.lazyAssets);
+        }
+        {
+            StartupStage stage("modelDatabase");
+            ModelDatabase::init(config.quantizeModels, engine.getJobSystem(), config.lazyAssets);
+        }
+    }
+    if (!config.headless) {
+        StartupStage stage("soundDatabase");
+        SoundDatabase::init(config.lazyAssets);
+    }
 
     LOG(INFO) << "Primary initialization done.";
 
     engine.init();
 
-    //TODO: Would it be possible to move this to the engine constructor?
-    glfwSetCursorPosCallback(engine.getWindow(), [](GLFWwindow *window, double x, double y) {
-        auto *engine = static_cast<Engine *>( glfwGetWindowUserPointer(window));
-        engine->mouseCallbackFunc(window, x, y);
-    });
-    engine.runLoop();
+    if (config.headless) {
+        engine.runHeadless();
+    } else {
+        //TODO: Would it be possible to move this to the engine constructor?
+        glfwSetCursorPosCallback(engine.getWindow(), [](GLFWwindow *window, double x, double y) {
+            auto *engine = static_cast<Engine *>( glfwGetWindowUserPointer(window));
+            engine->mouseCallbackFunc(window, x, y);
+        });
+        engine.runLoop();
+    }
+
+    PROFILE_WRITE_TRACE("profile_trace.json");
+    AsyncLogSink::stop();
 }
 
 /// Sets up some logging attributes from config file and flags
@@ -59,6 +103,9 @@ void initLogging() {
 
     //Reconfigure all loggers
     el::Loggers::reconfigureAllLoggers(conf);
+
+    // the console and the log file are written from a background thread
+    AsyncLogSink::start();
 }
 
 Config cliConfig() {
@@ -109,4 +156,97 @@ Config cliConfig() {
 
     std::cout.flush();
     return conf;
-}
\ No newline at end of file
+}
+
+/// Prints the command line flags
+static void printUsage(const char *program) {
+    std::cout << "Usage: " << program << " [flags]\n"
+              << "  --window WxH       window size (default " << EngineConstants::DEFAULT_WINDOW_WIDTH << "x"
+              << EngineConstants::DEFAULT_WINDOW_HEIGHT << ")\n"
+              << "  --world-size s|m|l world size (default s)\n"
+              << "  --seed N           world seed (default random)\n"
+              << "  --fov F            field of view (default 45)\n"
+              << "  --headless         no window or input: fly a fixed camera path, then write a report and exit\n"
+              << "  --frames N         number of headless frames (default " << EngineConstants::DEFAULT_HEADLESS_FRAMES
+              << ")\n"
+              << "  --report PATH      where to write the headless report (default "
+              << EngineConstants::HEADLESS_REPORT_PATH << ")\n"
+              << "  --record PATH      record the session's input to a file\n"
+              << "  --replay PATH      replay a recorded session headlessly, on the same world, then write a report\n"
+              << "  --render-stats N   log the draw calls, vertices, binds and frustum tests every N frames\n"
+              << "  --startup-report PATH  where to write the startup timings (default "
+              << EngineConstants::STARTUP_REPORT_PATH << ")\n"
+              << "  --quantize-models  store the models' vertices as half floats and normalized integers\n"
+              << "  --lazy-assets      load textures, models and music when first used, evicting unused ones\n"
+              << "Without flags, the settings are asked for interactively." << std::endl;
+}
+
+/// Reads the config from the command line flags. Returns false if the program should exit instead of running.
+bool argsConfig(int argc, char *argv[], Config &conf) {
+    try {
+        for (int i = 1; i < argc; i++) {
+            std::string flag = argv[i];
+            bool hasValue = i + 1 < argc;
+
+            if (flag == "--headless") {
+                conf.headless = true;
+            } else if (flag == "--quantize-models") {
+                conf.quantizeModels = true;
+            } else if (flag == "--lazy-assets") {
+                conf.lazyAssets = true;
+            } else if (flag == "--help" || flag == "-h") {
+                printUsage(argv[0]);
+                return false;
+            } else if (!hasValue) {
+                std::cerr << "Missing value or unknown flag " << flag << "." << std::endl;
+                printUsage(argv[0]);
+                return false;
+            } else if (flag == "--window") {
+                std::string winSize = argv[++i];
+                size_t seperator = winSize.find('x');
+                conf.windowWidth = stoi(winSize.substr(0, seperator));
+                conf.windowHeight = stoi(winSize.substr(seperator + 1, winSize.size()));
+            } else if (flag == "--world-size") {
+                switch (argv[++i][0]) {
+                    case 's':
+                        conf.worldSize = EngineConstants::SMALL_WORLD;
+                        break;
+                    case 'm':
+                        conf.worldSize = EngineConstants::MEDIUM_WORLD;
+                        break;
+                    case 'l':
+                        conf.worldSize = EngineConstants::LARGE_WORLD;
+                        break;
+                    default: {
+                        conf.worldSize = EngineConstants::MEDIUM_WORLD;
+                    }
+                }
+            } else if (flag == "--seed") {
+                conf.seed = stoi(argv[++i]);
+            } else if (flag == "--fov") {
+                conf.fov = stof(argv[++i]);
+            } else if (flag == "--frames") {
+                conf.frames = static_cast<unsigned int>(stoul(argv[++i]));
+            } else if (flag == "--report") {
+                conf.reportPath = argv[++i];
+            } else if (flag == "--record") {
+                conf.recordPath = argv[++i];
+            } else if (flag == "--replay") {
+                conf.replayPath = argv[++i];
+            } else if (flag == "--render-stats") {
+                conf.renderStatsInterval = static_cast<unsigned int>(stoul(argv[++i]));
+            } else if (flag == "--startup-report") {
+                conf.startupReportPath = argv[++i];
+            } else {
+                std::cerr << "Unknown flag " << flag << "." << std::endl;
+                printUsage(argv[0]);
+                return false;
+            }
+        }
+    } catch (const std::exception &e) {
+        std::cerr << "Invalid flag value: " << e.what() << std::endl;
+        printUsage(argv[0]);
+        return false;
+    }
+    return true;
+}
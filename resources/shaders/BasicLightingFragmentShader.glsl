@@ -12,6 +12,7 @@ uniform vec3 lightColor = vec3(1.0f, 1.0f, 1.0f);
 uniform sampler2D texture2D;
 uniform samplerCube textureCubeMap;
 uniform bool isCubeMap = false;
+uniform float alpha = 1.0;
 
 void main()
 {
@@ -44,5 +45,5 @@ void main()
     if (lightPos.y < FragPos.y) {
         result = ambient;
     }
-    FragColor = vec4(result, 1.0);
+    FragColor = vec4(result, alpha);
 }
\ No newline at end of file
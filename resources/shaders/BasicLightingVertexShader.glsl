@@ -2,6 +2,7 @@
 layout (location = 0) in vec3 aPos;
 layout (location = 1) in vec3 aNormal;
 layout (location = 2) in vec2 aTexCoords;
+layout (location = 3) in vec3 aLocalPos;
 
 out vec3 FragPos;
 out vec3 Normal;
@@ -15,7 +16,7 @@ uniform mat4 projection;
 void main()
 {
     FragPos = vec3(model * vec4(aPos, 1.0));
-    Pos = aPos;
+    Pos = aLocalPos;
     Normal = mat3(transpose(inverse(model))) * aNormal;
     TexCoords = aTexCoords;
 
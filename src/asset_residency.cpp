@@ -0,0 +1,62 @@
+//
+// Created on 10/19/2026.
+//
+#include "../include/asset_residency.h"
+
+size_t AssetResidency::add(bool pinned) {
+    Slot slot;
+    slot.pinned = pinned;
+    slots.push_back(slot);
+    return slots.size() - 1;
+}
+
+bool AssetResidency::use(size_t index) {
+    Slot &slot = slots[index];
+    slot.lastUsedFrame = frame;
+    if (slot.state != ASSET_UNLOADED)
+        return false;
+    slot.state = ASSET_LOADING;
+    return true;
+}
+
+void AssetResidency::loaded(size_t index, int64_t bytes) {
+    Slot &slot = slots[index];
+    slot.state = ASSET_RESIDENT;
+    slot.bytes = bytes;
+    stats.loads++;
+    stats.residentCount++;
+    stats.residentBytes += bytes;
+}
+
+void AssetResidency::failed(size_t index) {
+    slots[index].state = ASSET_FAILED;
+}
+
+std::vector<size_t> AssetResidency::nextFrame(const std::function<bool(size_t)> &canEvict) {
+    std::vector<size_t> evicted;
+    while (budget > 0 && stats.residentBytes > budget) {
+        // a linear scan: databases hold tens of assets, not thousands
+        size_t oldest = slots.size();
+        for (size_t i = 0; i < slots.size(); i++) {
+            const Slot &slot = slots[i];
+            if (slot.state != ASSET_RESIDENT || slot.pinned || slot.lastUsedFrame >= frame)
+                continue;
+            if (oldest == slots.size() || slot.lastUsedFrame < slots[oldest].lastUsedFrame) {
+                if (!canEvict || canEvict(i))
+                    oldest = i;
+            }
+        }
+        if (oldest == slots.size())
+            break; // everything left is in use, the budget is exceeded until some of it isn't
+
+        Slot &slot = slots[oldest];
+        slot.state = ASSET_UNLOADED;
+        stats.evictions++;
+        stats.residentCount--;
+        stats.residentBytes -= slot.bytes;
+        slot.bytes = 0;
+        evicted.push_back(oldest);
+    }
+    frame++;
+    return evicted;
+}
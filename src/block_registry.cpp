@@ -0,0 +1,145 @@
+//
+// Created on 10/19/2026.
+//
+#include <algorithm>
+#include <charconv>
+#include "../libs/easylogging++.h"
+#include "../include/block_registry.h"
+#include "../include/profiler.h"
+#include "../include/resource_pack.h"
+
+#ifdef ENGINE_COMPILED_BLOCKS
+// COMPILED_BLOCKS, written from resources/blocks by tools/generate_block_table.py
+#include "block_table.generated.h"
+#endif
+
+BlockRegistry BlockRegistry::instance;
+
+/// Removes the spaces and carriage returns around a value
+static std::string_view trim(std::string_view text) {
+    size_t first = text.find_first_not_of(" \t\r");
+    if (first == std::string_view::npos)
+        return {};
+    return text.substr(first, text.find_last_not_of(" \t\r") - first + 1);
+}
+
+std::ostream &operator<<(std::ostream &os, BlockID blockId) {
+    if (static_cast<unsigned int>(blockId) < BLOCK_ID_COUNT && BlockRegistry::get(blockId).defined)
+        return os << BlockRegistry::get(blockId).name;
+    return os << "block " << static_cast<int>(blockId);
+}
+
+void BlockRegistry::init() {
+    PROFILE_FUNCTION();
+
+    instance.table = {};
+    for (unsigned int id = 0; id < BLOCK_ID_COUNT; id++)
+        instance.table[id].id = static_cast<BlockID>(id);
+    instance.definedBlocks.clear();
+    instance.slots = {};
+    instance.strings.clear();
+
+#ifdef ENGINE_COMPILED_BLOCKS
+    for (const BlockProperties &block : COMPILED_BLOCKS)
+        instance.add(block, "the compiled block table");
+#else
+    for (const auto &name : ResourcePack::list("blocks")) {
+        Resource file = ResourcePack::load("blocks/" + name);
+        instance.parse(name, file.view());
+    }
+#endif
+
+    std::sort(instance.definedBlocks.begin(), instance.definedBlocks.end());
+    LOG(INFO) << "Registered " << instance.definedBlocks.size() << " blocks"
+              << (isCompiled() ? " from the compiled table." : ".");
+}
+
+bool BlockRegistry::isCompiled() {
+#ifdef ENGINE_COMPILED_BLOCKS
+    return true;
+#else
+    return false;
+#endif
+}
+
+void BlockRegistry::parse(const std::string &fileName, std::string_view text) {
+    BlockProperties block;
+    bool hasID = false;
+
+    while (!text.empty()) {
+        size_t end = text.find('\n');
+        std::string_view line = text.substr(0, end);
+        text = end == std::string_view::npos ? std::string_view() : text.substr(end + 1);
+
+        size_t delimiter = line.find(':');
+        if (delimiter == std::string_view::npos)
+            continue;
+        std::string_view key = trim(line.substr(0, delimiter));
+        std::string_view value = trim(line.substr(delimiter + 1));
+        if (key.empty() || value.empty())
+            continue;
+
+        if (key == "ID") {
+            int id = -1;
+            std::from_chars(value.data(), value.data() + value.size(), id);
+            block.id = static_cast<BlockID>(id);
+            hasID = true;
+        } else if (key == "name") {
+            block.name = intern(std::string(value));
+        } else if (key == "model") {
+            block.model = intern("models/" + std::string(value));
+        } else if (key == "all") {
+            block.texture = intern("textures/" + std::string(value));
+            block.textureType = TEXTURE2D;
+        } else if (key == "sound") {
+            block.placeSound = intern(std::string(value));
+        } else if (key == "opaque") {
+            block.opaque = value == "true";
+        } else if (key == "transparent") {
+            block.transparent = value == "true";
+        } else if (key == "breakable") {
+            block.breakable = value == "true";
+        } else if (key == "slot") {
+            std::from_chars(value.data(), value.data() + value.size(), block.slot);
+        } else {
+            static constexpr std::string_view FACE_KEYS[BLOCK_FACE_COUNT] = {"right", "left", "top", "bottom",
+                                                                             "back", "front"};
+            auto face = std::find(std::begin(FACE_KEYS), std::end(FACE_KEYS), key);
+            if (face == std::end(FACE_KEYS)) {
+                LOG(WARNING) << "Unknown key \"" << key << "\" in " << fileName << ".";
+                continue;
+            }
+            block.faces[face - std::begin(FACE_KEYS)] = intern("textures/" + std::string(value));
+            block.textureType = CUBEMAP;
+        }
+    }
+
+    if (!hasID) {
+        LOG(WARNING) << fileName << " has no block ID, skipping it.";
+        return;
+    }
+    block.defined = true;
+    add(block, fileName);
+}
+
+std::string_view BlockRegistry::intern(std::string value) {
+    return strings.emplace_back(std::move(value));
+}
+
+bool BlockRegistry::add(const BlockProperties &block, const std::string &source) {
+    auto id = static_cast<unsigned int>(block.id);
+    if (id >= BLOCK_ID_COUNT) {
+        LOG(WARNING) << "Invalid block ID " << static_cast<int>(block.id) << " in " << source << ".";
+        return false;
+    }
+    if (table[id].defined) {
+        LOG(WARNING) << "Block ID " << id << " of " << source << " is already used by " << table[id].name << ".";
+        return false;
+    }
+
+    table[id] = block;
+    definedBlocks.push_back(block.id);
+    if (block.slot >= 1 && block.slot <= SLOT_COUNT)
+        slots[block.slot - 1] = block.id;
+    return true;
+}
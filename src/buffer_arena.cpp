@@ -0,0 +1,238 @@
+//
+// Created on 10/19/2026.
+//
+#include <algorithm>
+#include "../libs/easylogging++.h"
+#include "../include/buffer_arena.h"
+
+/// Rounds value up to the next multiple of alignment
+static GLintptr alignUp(GLintptr value, GLsizeiptr alignment) {
+    return ((value + alignment - 1) / alignment) * alignment;
+}
+
+BufferArena::BufferArena(GLsizeiptr pageSize) {
+    this->pageSize = pageSize;
+    addPage(pageSize);
+}
+
+BufferArena::~BufferArena() {
+    for (auto &page : pages) {
+        glDeleteBuffers(1, &page.bufferId);
+    }
+}
+
+void BufferArena::addPage(GLsizeiptr capacity) {
+
+    LOG(INFO) << "Adding page " << pages.size() << " of " << capacity << " bytes to buffer arena.";
+
+    // bound to the copy targets so that the current vertex array's bindings are left alone
+    Page page{0, capacity, {{0, capacity}}};
+    glGenBuffers(1, &page.bufferId);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, page.bufferId);
+    glBufferData(GL_COPY_WRITE_BUFFER, capacity, nullptr, GL_DYNAMIC_DRAW);
+    pages.push_back(std::move(page));
+}
+
+bool BufferArena::allocateFromPage(unsigned int pageIndex, GLsizeiptr size, GLsizeiptr alignment, Range &out) {
+
+    Page &page = pages[pageIndex];
+    for (size_t i = 0; i < page.freeRanges.size(); i++) {
+        Range freeRange = page.freeRanges[i];
+        GLintptr start = alignUp(freeRange.offset, alignment);
+        if (start + size > freeRange.offset + freeRange.size)
+            continue;
+
+        page.freeRanges.erase(page.freeRanges.begin() + static_cast<long>(i));
+        // padding in front of the aligned start and the tail both go back to the free list
+        if (start > freeRange.offset)
+            insertFreeRange(page, {freeRange.offset, start - freeRange.offset});
+        GLintptr end = start + size;
+        if (end < freeRange.offset + freeRange.size)
+            insertFreeRange(page, {end, freeRange.offset + freeRange.size - end});
+
+        out = {start, size};
+        return true;
+    }
+    return false;
+}
+
+BufferArena::Handle BufferArena::allocate(GLsizeiptr size, GLsizeiptr alignment) {
+
+    Allocation allocation{0, {0, 0}, alignment};
+    bool found = false;
+    for (unsigned int page = 0; page < pages.size() && !found; page++) {
+        found = allocateFromPage(page, size, alignment, allocation.range);
+        allocation.page = page;
+    }
+    if (!found) {
+        addPage(std::max(pageSize, alignUp(size, alignment)));
+        allocation.page = static_cast<unsigned int>(pages.size() - 1);
+        allocateFromPage(allocation.page, size, alignment, allocation.range);
+    }
+
+    Handle handle = nextHandle++;
+    allocations[handle] = allocation;
+    bytesInUse += size;
+    return handle;
+}
+
+void BufferArena::release(Handle handle) {
+    auto allocation = allocations.find(handle);
+    if (allocation == allocations.end())
+        return;
+    insertFreeRange(pages[allocation->second.page], allocation->second.range);
+    bytesInUse -= allocation->second.range.size;
+    allocations.erase(allocation);
+}
+
+bool BufferArena::resize(Handle handle, GLsizeiptr size) {
+    auto found = allocations.find(handle);
+    if (found == allocations.end())
+        return false;
+
+    Range &range = found->second.range;
+    Page &page = pages[found->second.page];
+    GLintptr end = range.offset + range.size;
+
+    if (size <= range.size) {
+        if (size < range.size)
+            insertFreeRange(page, {range.offset + size, range.size - size});
+        bytesInUse -= range.size - size;
+        range.size = size;
+        return true;
+    }
+
+    // grow into the free range that starts right where this one ends, if there is one
+    auto next = std::lower_bound(page.freeRanges.begin(), page.freeRanges.end(), end,
+                                 [](const Range &free, GLintptr offset) { return free.offset < offset; });
+    GLsizeiptr extra = size - range.size;
+    if (next == page.freeRanges.end() || next->offset != end || next->size < extra)
+        return false;
+
+    next->offset += extra;
+    next->size -= extra;
+    if (next->size == 0)
+        page.freeRanges.erase(next);
+    bytesInUse += extra;
+    range.size = size;
+    return true;
+}
+
+void BufferArena::write(Handle handle, GLintptr offset, const void *data, GLsizeiptr size) {
+    auto allocation = allocations.find(handle);
+    if (allocation == allocations.end() || offset + size > allocation->second.range.size) {
+        LOG(WARNING) << "Invalid write of " << size << " bytes to buffer arena range " << handle;
+        return;
+    }
+    glBindBuffer(GL_COPY_WRITE_BUFFER, pages[allocation->second.page].bufferId);
+    glBufferSubData(GL_COPY_WRITE_BUFFER, allocation->second.range.offset + offset, size, data);
+}
+
+void BufferArena::defragment() {
+
+    BufferArenaStats before = getStats();
+    GLuint scratchId = 0;
+    GLsizeiptr scratchSize = 0;
+
+    for (unsigned int pageIndex = 0; pageIndex < pages.size(); pageIndex++) {
+        Page &page = pages[pageIndex];
+        if (page.freeRanges.size() <= 1 &&
+            (page.freeRanges.empty() || page.freeRanges[0].offset + page.freeRanges[0].size == page.capacity))
+            continue; // already packed
+
+        std::vector<Allocation *> pageAllocations;
+        for (auto &pair : allocations) {
+            if (pair.second.page == pageIndex)
+                pageAllocations.push_back(&pair.second);
+        }
+        std::sort(pageAllocations.begin(), pageAllocations.end(),
+                  [](const Allocation *a, const Allocation *b) { return a->range.offset < b->range.offset; });
+
+        // ranges may overlap their new place, so the page is staged in a scratch buffer and copied back packed
+        if (scratchSize < page.capacity) {
+            if (scratchId != 0)
+                glDeleteBuffers(1, &scratchId);
+            glGenBuffers(1, &scratchId);
+            glBindBuffer(GL_COPY_WRITE_BUFFER, scratchId);
+            glBufferData(GL_COPY_WRITE_BUFFER, page.capacity, nullptr, GL_STREAM_COPY);
+            scratchSize = page.capacity;
+        }
+        glBindBuffer(GL_COPY_READ_BUFFER, page.bufferId);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, scratchId);
+        glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, page.capacity);
+
+        glBindBuffer(GL_COPY_READ_BUFFER, scratchId);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, page.bufferId);
+        page.freeRanges.clear();
+        GLintptr end = 0;
+        for (Allocation *allocation : pageAllocations) {
+            GLintptr start = alignUp(end, allocation->alignment);
+            if (start > end)
+                page.freeRanges.push_back({end, start - end});
+            glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, allocation->range.offset, start,
+                                allocation->range.size);
+            allocation->range.offset = start;
+            end = start + allocation->range.size;
+        }
+        if (end < page.capacity)
+            page.freeRanges.push_back({end, page.capacity - end});
+    }
+
+    if (scratchId != 0)
+        glDeleteBuffers(1, &scratchId);
+
+    LOG(INFO) << "Defragmented buffer arena, fragmentation went from " << before.fragmentation() << " to "
+              << getStats().fragmentation() << ".";
+}
+
+GLintptr BufferArena::getOffset(Handle handle) const {
+    auto allocation = allocations.find(handle);
+    return allocation == allocations.end() ? 0 : allocation->second.range.offset;
+}
+
+GLsizeiptr BufferArena::getSize(Handle handle) const {
+    auto allocation = allocations.find(handle);
+    return allocation == allocations.end() ? 0 : allocation->second.range.size;
+}
+
+unsigned int BufferArena::getPage(Handle handle) const {
+    auto allocation = allocations.find(handle);
+    return allocation == allocations.end() ? 0 : allocation->second.page;
+}
+
+BufferArenaStats BufferArena::getStats() const {
+    BufferArenaStats stats;
+    stats.pageCount = static_cast<unsigned int>(pages.size());
+    stats.allocationCount = static_cast<unsigned int>(allocations.size());
+    stats.bytesInUse = bytesInUse;
+    for (const auto &page : pages) {
+        stats.capacity += page.capacity;
+        for (const auto &range : page.freeRanges) {
+            stats.largestFreeRange = std::max(stats.largestFreeRange, range.size);
+        }
+    }
+    return stats;
+}
+
+void BufferArena::insertFreeRange(Page &page, Range range) {
+
+    auto &freeRanges = page.freeRanges;
+    auto position = std::lower_bound(freeRanges.begin(), freeRanges.end(), range,
+                                     [](const Range &a, const Range &b) { return a.offset < b.offset; });
+    position = freeRanges.insert(position, range);
+
+    // merge with the next range
+    auto next = position + 1;
+    if (next != freeRanges.end() && position->offset + position->size == next->offset) {
+        position->size += next->size;
+        freeRanges.erase(next);
+    }
+    // merge with the previous range
+    if (position != freeRanges.begin()) {
+        auto previous = position - 1;
+        if (previous->offset + previous->size == position->offset) {
+            previous->size += position->size;
+            freeRanges.erase(position);
+        }
+    }
+}
@@ -0,0 +1,35 @@
+//
+// Created on 10/19/2026.
+//
+#include <fstream>
+#include <thread>
+#include "../libs/easylogging++.h"
+#include "../include/cache_file.h"
+
+std::filesystem::path CacheFile::getPath(const char *cacheDir, const std::string &sourcePath, const char *extension) {
+    return std::filesystem::path(cacheDir) / (std::filesystem::path(sourcePath).filename().string() + extension);
+}
+
+bool CacheFile::write(const std::filesystem::path &path, const std::string &sourcePath,
+                      const std::function<void(std::ostream &)> &write) {
+    std::error_code error;
+    std::filesystem::create_directories(path.parent_path(), error);
+    std::filesystem::path temporary = path.string() + "." +
+                                      std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())) + ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            LOG(WARNING) << "Could not open " << temporary << " to cache " << sourcePath << ".";
+            return false;
+        }
+        write(file);
+        if (!file) {
+            LOG(WARNING) << "Could not write the cache entry of " << sourcePath << ".";
+            file.close();
+            std::filesystem::remove(temporary, error);
+            return false;
+        }
+    }
+    std::filesystem::rename(temporary, path, error);
+    return !error;
+}
@@ -0,0 +1,178 @@
+//
+// Created on 10/19/2026.
+//
+#include <limits>
+#include <unordered_set>
+#include <glm/gtc/matrix_inverse.hpp>
+#include "../include/chunk_mesh.h"
+#include "../include/block_registry.h"
+#include "../include/cube_geometry.h"
+#include "../include/profiler.h"
+
+/// Packs the integer block coordinates of a world position into a single key
+static uint64_t packBlockCoords(glm::vec3 worldPos) {
+    auto x = static_cast<uint64_t>(static_cast<int>(std::floor(worldPos.x))) & 0x1FFFFFu;
+    auto y = static_cast<uint64_t>(static_cast<int>(std::floor(worldPos.y))) & 0x1FFFFFu;
+    auto z = static_cast<uint64_t>(static_cast<int>(std::floor(worldPos.z))) & 0x1FFFFFu;
+    return (x << 42u) | (y << 21u) | z;
+}
+
+/// The offset to the neighbouring block each face of the cube looks at
+static const glm::vec3 FACE_NEIGHBOURS[6] = {{0, 0, -1}, {0, 0, 1}, {-1, 0, 0}, {1, 0, 0}, {0, -1, 0}, {0, 1, 0}};
+
+/// Returns true if the entity is an unrotated, unscaled block sitting exactly on the grid
+static bool isGridAlignedBlock(Entity &entity) {
+    Transform &transform = entity.getTransform();
+    return transform.getScale() == glm::vec3(1.0f) && transform.getRotation() == glm::quat(glm::vec3(0.0f)) &&
+           glm::floor(transform.getPosition()) == transform.getPosition();
+}
+
+/// Appends one face of the unit cube, transformed by the given matrix
+static void appendFace(const CubeFace &face, const glm::mat4 &modelMatrix, const glm::mat3 &normalMatrix,
+                       ChunkMeshData &data) {
+
+    auto firstVertex = static_cast<unsigned int>(data.vertices.size());
+    for (unsigned int corner = 0; corner < 4; corner++) {
+        ChunkVertex vertex{};
+        vertex.position = glm::vec3(modelMatrix * glm::vec4(face.corners[corner], 1.0f));
+        vertex.normal = glm::normalize(normalMatrix * face.normal);
+        vertex.textureCoordinate = face.textureCoordinates[corner];
+        vertex.localPosition = face.corners[corner];
+        data.vertices.push_back(vertex);
+
+        data.boundsMin = glm::min(data.boundsMin, vertex.position);
+        data.boundsMax = glm::max(data.boundsMax, vertex.position);
+    }
+    for (unsigned int index : CubeGeometry::FACE_INDICES)
+        data.indices.push_back(firstVertex + index);
+}
+
+ChunkMeshData bakeChunkMesh(const std::map<BlockID, std::vector<std::shared_ptr<Entity>>> &entitiesByBlockID) {
+    PROFILE_FUNCTION();
+
+    ChunkMeshData data;
+    data.boundsMin = glm::vec3(std::numeric_limits<float>::max());
+    data.boundsMax = glm::vec3(std::numeric_limits<float>::lowest());
+
+    // opaque blocks hide the faces of their neighbours, and anything in a cell covers the water below it
+    std::unordered_set<uint64_t> solid;
+    std::unordered_set<uint64_t> occupied;
+    for (const auto &pair : entitiesByBlockID) {
+        for (const auto &ent : pair.second) {
+            uint64_t key = packBlockCoords(ent->getTransform().getPosition());
+            occupied.insert(key);
+            if (BlockRegistry::isOpaque(pair.first) && isGridAlignedBlock(*ent))
+                solid.insert(key);
+        }
+    }
+
+    // transparent blocks are drawn as surfaces in the translucent pass, only water for now
+    for (const auto &pair : entitiesByBlockID) {
+        if (BlockRegistry::isTransparent(pair.first) || pair.second.empty())
+            continue;
+
+        auto firstIndex = static_cast<unsigned int>(data.indices.size());
+        for (const auto &ent : pair.second) {
+            Transform &transform = ent->getTransform();
+            bool aligned = isGridAlignedBlock(*ent);
+            glm::mat3 normalMatrix = glm::inverseTranspose(glm::mat3(transform.getModelMatrix()));
+
+            for (unsigned int direction = 0; direction < 6; direction++) {
+                if (aligned && solid.count(packBlockCoords(transform.getPosition() + FACE_NEIGHBOURS[direction])))
+                    continue;
+                appendFace(CubeGeometry::FACES[direction], transform.getModelMatrix(), normalMatrix, data);
+            }
+        }
+
+        auto indexCount = static_cast<unsigned int>(data.indices.size()) - firstIndex;
+        if (indexCount > 0)
+            data.subMeshes.push_back({pair.first, firstIndex, indexCount});
+    }
+
+    // water goes last so that its indices can be re-sorted in place
+    std::vector<glm::vec3> exposedWater;
+    auto water = entitiesByBlockID.find(BlockID::WATER);
+    if (water != entitiesByBlockID.end()) {
+        for (const auto &ent : water->second) {
+            glm::vec3 pos = ent->getTransform().getPosition();
+            if (!occupied.count(packBlockCoords(pos + FACE_NEIGHBOURS[CubeGeometry::POS_Y]))) {
+                exposedWater.push_back(glm::floor(pos));
+                data.boundsMin = glm::min(data.boundsMin, glm::floor(pos));
+                data.boundsMax = glm::max(data.boundsMax, glm::floor(pos) + glm::vec3(1.0f));
+            }
+        }
+    }
+    data.waterFirstIndex = static_cast<unsigned int>(data.indices.size());
+    data.water.build(exposedWater, data.vertices, data.indices);
+
+    if (data.vertices.empty()) {
+        data.boundsMin = glm::vec3(0.0f);
+        data.boundsMax = glm::vec3(0.0f);
+    }
+    return data;
+}
+
+void ChunkMesh::upload(BufferArena &arena, ChunkMeshData &&data) {
+    PROFILE_FUNCTION();
+
+    vertexCount = static_cast<unsigned int>(data.vertices.size());
+    indexCount = static_cast<unsigned int>(data.indices.size());
+    subMeshes = std::move(data.subMeshes);
+    waterFirstIndex = data.waterFirstIndex;
+    water = std::move(data.water);
+    boundsMin = data.boundsMin;
+    boundsMax = data.boundsMax;
+
+    if (indexCount == 0) {
+        if (allocation != BufferArena::INVALID_HANDLE)
+            arena.release(allocation);
+        allocation = BufferArena::INVALID_HANDLE;
+        return;
+    }
+
+    // vertices first, then the indices, in one range aligned to the vertex stride so that the base vertex is exact
+    GLsizeiptr vertexBytes = vertexCount * static_cast<GLsizeiptr>(sizeof(ChunkVertex));
+    GLsizeiptr indexBytes = indexCount * static_cast<GLsizeiptr>(sizeof(unsigned int));
+
+    // a chunk that lost blocks is rewritten where it is
+    if (allocation == BufferArena::INVALID_HANDLE || !arena.resize(allocation, vertexBytes + indexBytes)) {
+        if (allocation != BufferArena::INVALID_HANDLE)
+            arena.release(allocation);
+        allocation = arena.allocate(vertexBytes + indexBytes, sizeof(ChunkVertex));
+    }
+    arena.write(allocation, 0, data.vertices.data(), vertexBytes);
+    arena.write(allocation, vertexBytes, data.indices.data(), indexBytes);
+}
+
+void ChunkMesh::release(BufferArena &arena) {
+    if (allocation != BufferArena::INVALID_HANDLE)
+        arena.release(allocation);
+    allocation = BufferArena::INVALID_HANDLE;
+    vertexCount = 0;
+    indexCount = 0;
+    subMeshes.clear();
+}
+
+void ChunkMesh::sortWater(BufferArena &arena, const glm::vec3 &viewPos) {
+    if (water.isEmpty() || allocation == BufferArena::INVALID_HANDLE || !water.needsResort(viewPos))
+        return;
+
+    water.sortBackToFront(viewPos, waterIndices);
+    GLsizeiptr offset = vertexCount * static_cast<GLsizeiptr>(sizeof(ChunkVertex)) +
+                        waterFirstIndex * static_cast<GLsizeiptr>(sizeof(unsigned int));
+    arena.write(allocation, offset, waterIndices.data(),
+                static_cast<GLsizeiptr>(waterIndices.size() * sizeof(unsigned int)));
+}
+
+GLint ChunkMesh::getBaseVertex(const BufferArena &arena) const {
+    return static_cast<GLint>(arena.getOffset(allocation) / static_cast<GLintptr>(sizeof(ChunkVertex)));
+}
+
+unsigned int ChunkMesh::getPage(const BufferArena &arena) const {
+    return arena.getPage(allocation);
+}
+
+GLuint ChunkMesh::getFirstIndex(const BufferArena &arena) const {
+    GLintptr indexStart = arena.getOffset(allocation) + vertexCount * static_cast<GLintptr>(sizeof(ChunkVertex));
+    return static_cast<GLuint>(indexStart / static_cast<GLintptr>(sizeof(unsigned int)));
+}
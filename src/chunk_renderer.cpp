@@ -0,0 +1,242 @@
+//
+// Created on 10/19/2026.
+//
+#include <algorithm>
+#include "../libs/easylogging++.h"
+#include "../include/chunk_renderer.h"
+#include "../include/block_registry.h"
+#include "../include/gl_state.h"
+#include "../include/render_stats.h"
+#include "../include/texture_database.h"
+#include "../include/profiler.h"
+
+static const glm::mat4 IDENTITY_MATRIX = glm::mat4(1.0f);
+
+ChunkBatch::ChunkBatch(const ChunkRenderer *renderer, GLuint vaoId, unsigned int firstCommand,
+                       unsigned int commandCount) {
+    this->renderer = renderer;
+    this->vaoId = vaoId;
+    this->firstCommand = firstCommand;
+    this->commandCount = commandCount;
+}
+
+void ChunkBatch::draw() const {
+    GLStateCache::bindVertexArray(vaoId);
+
+    const auto &commands = renderer->getCommands();
+    uint64_t indexCount = 0;
+    for (unsigned int i = firstCommand; i < firstCommand + commandCount; i++)
+        indexCount += commands[i].count;
+    RenderStats::count(DRAW_COMMANDS, commandCount);
+    RenderStats::count(VERTICES, indexCount);
+
+    if (renderer->usesMultiDrawIndirect()) {
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, renderer->getIndirectBufferId());
+        glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT,
+                                    (void *) (firstCommand * sizeof(DrawElementsIndirectCommand)),
+                                    static_cast<GLsizei>(commandCount), 0);
+        RenderStats::count(DRAW_CALLS);
+        return;
+    }
+
+    for (unsigned int i = firstCommand; i < firstCommand + commandCount; i++) {
+        glDrawElementsBaseVertex(GL_TRIANGLES, static_cast<GLsizei>(commands[i].count), GL_UNSIGNED_INT,
+                                 (void *) (commands[i].firstIndex * sizeof(GLuint)), commands[i].baseVertex);
+    }
+    RenderStats::count(DRAW_CALLS, commandCount);
+}
+
+GLuint ChunkBatch::getVaoId() const {
+    return vaoId;
+}
+
+ChunkRenderer::ChunkRenderer(JobSystem &jobs) : jobs(jobs), arena(ARENA_PAGE_SIZE) {
+
+    multiDrawIndirect = GLEW_VERSION_4_3 || GLEW_ARB_multi_draw_indirect;
+    LOG(INFO) << "Drawing chunks with "
+              << (multiDrawIndirect ? "glMultiDrawElementsIndirect." : "glDrawElementsBaseVertex (no multi-draw).");
+
+    createPageVaos();
+
+    if (multiDrawIndirect)
+        glGenBuffers(1, &indirectBufferId);
+}
+
+ChunkRenderer::~ChunkRenderer() {
+    glDeleteVertexArrays(static_cast<GLsizei>(pageVaos.size()), pageVaos.data());
+    for (GLuint vao : pageVaos)
+        GLStateCache::forgetVertexArray(vao);
+    if (indirectBufferId != 0)
+        glDeleteBuffers(1, &indirectBufferId);
+}
+
+void ChunkRenderer::createPageVaos() {
+
+    for (auto page = static_cast<unsigned int>(pageVaos.size()); page < arena.getPageCount(); page++) {
+        GLuint vaoId = 0;
+        glGenVertexArrays(1, &vaoId);
+        pageVaos.push_back(vaoId);
+
+        GLStateCache::bindVertexArray(vaoId);
+        glBindBuffer(GL_ARRAY_BUFFER, arena.getBufferId(page));
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, arena.getBufferId(page));
+
+        // vertex positions
+        glEnableVertexAttribArray(0);
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(ChunkVertex),
+                              (void *) offsetof(ChunkVertex, position));
+        // vertex normals
+        glEnableVertexAttribArray(1);
+        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(ChunkVertex),
+                              (void *) offsetof(ChunkVertex, normal));
+        // vertex texture coords
+        glEnableVertexAttribArray(2);
+        glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(ChunkVertex),
+                              (void *) offsetof(ChunkVertex, textureCoordinate));
+        // position inside the block, for cube maps
+        glEnableVertexAttribArray(3);
+        glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, sizeof(ChunkVertex),
+                              (void *) offsetof(ChunkVertex, localPosition));
+    }
+    GLStateCache::bindVertexArray(0);
+}
+
+void ChunkRenderer::beginFrame() {
+    visibleChunks.clear();
+
+    if (uploadsSinceDefragment > 0 && arena.getStats().fragmentation() > DEFRAGMENT_THRESHOLD) {
+        arena.defragment();
+        uploadsSinceDefragment = 0;
+    }
+}
+
+JobHandle ChunkRenderer::scheduleBake(Chunk &chunk) {
+
+    // blocks are never moved once placed, so holding on to them is enough for the job to read them safely while the
+    // chunk itself keeps changing
+    auto blocks = std::make_shared<std::map<BlockID, std::vector<std::shared_ptr<Entity>>>>(
+            chunk.getEntitiesByBlockID());
+    auto mesh = std::make_shared<ChunkMeshData>();
+    chunk.setMeshDirty(false);
+    bakesInFlight.insert(&chunk);
+
+    JobHandle bake = jobs.submit([blocks, mesh]() { *mesh = bakeChunkMesh(*blocks); });
+    return jobs.then(bake, [this, &chunk, mesh]() {
+        chunk.getMesh().upload(arena, std::move(*mesh));
+        bakesInFlight.erase(&chunk);
+        uploadsSinceDefragment++;
+    }, MAIN_THREAD);
+}
+
+void ChunkRenderer::rebuildChunks(const std::vector<std::shared_ptr<Chunk>> &chunks) {
+    std::vector<JobHandle> uploads;
+    uploads.reserve(chunks.size());
+    for (const auto &chunk : chunks) {
+        if (bakesInFlight.find(chunk.get()) == bakesInFlight.end())
+            uploads.push_back(scheduleBake(*chunk));
+    }
+    jobs.waitAll(uploads);
+}
+
+void ChunkRenderer::addChunk(Chunk &chunk, const ViewFrustum &frustum, const glm::vec3 &viewPos) {
+    PROFILE_FUNCTION();
+
+    if (chunk.isMeshDirty() && bakesInFlight.find(&chunk) == bakesInFlight.end())
+        scheduleBake(chunk);
+
+    const ChunkMesh &mesh = chunk.getMesh();
+    if (mesh.isEmpty() ||
+        !frustum.isBoxInFrustum(mesh.getBoundsMin(), BoundingBox(mesh.getBoundsMax() - mesh.getBoundsMin())))
+        return;
+
+    chunk.getMesh().sortWater(arena, viewPos);
+
+    glm::vec3 center = (mesh.getBoundsMin() + mesh.getBoundsMax()) * 0.5f;
+    visibleChunks.push_back({&mesh, mesh.getPage(arena), glm::distance(center, viewPos)});
+}
+
+void ChunkRenderer::releaseChunk(Chunk &chunk) {
+    chunk.getMesh().release(arena);
+    chunk.setMeshDirty(true);
+}
+
+void ChunkRenderer::addCommand(const ChunkMesh &mesh, unsigned int firstIndex, unsigned int indexCount) {
+    commands.push_back({indexCount, 1, mesh.getFirstIndex(arena) + firstIndex, mesh.getBaseVertex(arena), 0});
+}
+
+void ChunkRenderer::submitBatch(RenderQueue &queue, RenderPass pass, Shader &shader, BlockID blockId,
+                                unsigned int page, unsigned int firstCommand, float viewDepth, float opacity) {
+
+    auto commandCount = static_cast<unsigned int>(commands.size()) - firstCommand;
+    if (commandCount == 0)
+        return;
+
+    batches.push_back(std::make_unique<ChunkBatch>(this, pageVaos[page], firstCommand, commandCount));
+    queue.submit(pass, shader, TextureDatabase::getTextureByBlockId(blockId).get(), *batches.back(),
+                 &IDENTITY_MATRIX, viewDepth, opacity);
+}
+
+void ChunkRenderer::submit(RenderQueue &queue, Shader &shader) {
+    PROFILE_FUNCTION();
+
+    commands.clear();
+    batches.clear();
+    if (visibleChunks.empty())
+        return;
+
+    createPageVaos();
+
+    // front to back so that the nearest chunks fill the depth buffer first
+    std::sort(visibleChunks.begin(), visibleChunks.end(),
+              [](const VisibleChunk &a, const VisibleChunk &b) { return a.distance < b.distance; });
+
+    for (BlockID blockId : BlockRegistry::getDefinedBlocks()) {
+        if (BlockRegistry::isTransparent(blockId))
+            continue;
+        for (unsigned int page = 0; page < arena.getPageCount(); page++) {
+            auto firstCommand = static_cast<unsigned int>(commands.size());
+            float nearestDepth = 0.0f;
+            for (const auto &visible : visibleChunks) {
+                if (visible.page != page)
+                    continue;
+                for (const auto &subMesh : visible.mesh->getSubMeshes()) {
+                    if (subMesh.blockId != blockId)
+                        continue;
+                    // the chunks are sorted, so the first one in the batch is the nearest
+                    if (firstCommand == commands.size())
+                        nearestDepth = visible.distance;
+                    addCommand(*visible.mesh, subMesh.firstIndex, subMesh.indexCount);
+                }
+            }
+            submitBatch(queue, OPAQUE_PASS, shader, blockId, page, firstCommand, nearestDepth, 1.0f);
+        }
+    }
+
+    // water is blended, so the chunks go back to front, each already sorted internally. Consecutive chunks in the same
+    // page share a batch.
+    auto firstWaterCommand = static_cast<unsigned int>(commands.size());
+    unsigned int waterPage = 0;
+    float waterDepth = 0.0f;
+    for (auto visible = visibleChunks.rbegin(); visible != visibleChunks.rend(); visible++) {
+        if (visible->mesh->getWaterIndexCount() == 0)
+            continue;
+        if (visible->page != waterPage) {
+            submitBatch(queue, TRANSLUCENT_PASS, shader, BlockID::WATER, waterPage, firstWaterCommand, waterDepth,
+                        WaterSurface::OPACITY);
+            firstWaterCommand = static_cast<unsigned int>(commands.size());
+            waterPage = visible->page;
+        }
+        if (firstWaterCommand == commands.size())
+            waterDepth = visible->distance;
+        addCommand(*visible->mesh, visible->mesh->getWaterFirstIndex(), visible->mesh->getWaterIndexCount());
+    }
+    submitBatch(queue, TRANSLUCENT_PASS, shader, BlockID::WATER, waterPage, firstWaterCommand, waterDepth,
+                WaterSurface::OPACITY);
+
+    if (multiDrawIndirect && !commands.empty()) {
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, indirectBufferId);
+        glBufferData(GL_DRAW_INDIRECT_BUFFER,
+                     static_cast<GLsizeiptr>(commands.size() * sizeof(DrawElementsIndirectCommand)),
+                     commands.data(), GL_STREAM_DRAW);
+    }
+}
@@ -3,7 +3,9 @@
 //
 #include <random>
 #include <climits>
+#include <cstring>
 #include "../include/chunks.h"
+#include "../include/memory_stats.h"
 
 Chunk::Chunk(unsigned int xInd, unsigned int zInd) {
     this->origin = std::make_pair(xInd, zInd);
@@ -49,26 +51,6 @@ bool Chunk::isBlockOutOfBounds(glm::vec2 xzCoords) const {
                    origin.second * (EngineConstants::CHUNK_LENGTH + 1));
 }
 
-void Chunk::renderChunk(Shader &shader, const ViewFrustum &frustum) {
-
-    for (auto &pair : entitiesByBlockID) {
-        std::shared_ptr<TextureInterface> tex = TextureDatabase::getTextureByBlockId(pair.first);
-        tex->bindTexture();
-        if (tex->getTextureType() == CUBEMAP) {
-            shader.setBool("isCubeMap", true);
-            shader.setInt("textureCubeMap", 1);
-        } else {
-            shader.setBool("isCubeMap", false);
-            shader.setInt("texture2D", 0);
-        }
-        for (auto &ent : pair.second) {
-            if (frustum.isBoxInFrustum(ent->getTransform().getPosition(), ent->box)) {
-                ent->draw(shader);
-            }
-        }
-    }
-}
-
 size_t Chunk::getNumberOfEntities() const {
     return entities.size();
 }
@@ -85,6 +67,7 @@ bool Chunk::removeEntityByID(EntityID id) {
 
             // remove from entityID map
             entities.erase(id);
+            meshDirty = true;
 
             return true;
         }
@@ -98,11 +81,13 @@ std::optional<std::shared_ptr<Chunk>> ChunkManager::getChunkByXZ(const glm::vec2
     findKey.first = (int) xzCoords.x / EngineConstants::CHUNK_WIDTH;
     findKey.second = (int) xzCoords.y / EngineConstants::CHUNK_LENGTH;
 
-    if (chunks.find(findKey) == chunks.end()) {
-        LOG(DEBUG) << "Did not find Chunk at coords " << xzCoords.x << " " << xzCoords.y;
+    // find only reads the map, so this can run on the job system's workers
+    auto found = chunks.find(findKey);
+    if (found == chunks.end()) {
+        ENGINE_LOG_EVERY_MS(DEBUG, 1000) << "Did not find Chunk at coords " << xzCoords.x << " " << xzCoords.y;
         return {};
     } else {
-        return chunks[findKey];
+        return found->second;
     }
 }
 
@@ -110,12 +95,13 @@ std::optional<std::shared_ptr<Chunk>> ChunkManager::getChunkByXZIndex(unsigned i
 
     std::pair<unsigned int, unsigned int> findKey = std::make_pair(xInd, zInd);
 
-    if (chunks.find(findKey) == chunks.end()) {
-        LOG(DEBUG) << "Did not find Chunk at coords " << xInd * EngineConstants::CHUNK_WIDTH << " "
-                   << zInd * EngineConstants::CHUNK_LENGTH;
+    auto found = chunks.find(findKey);
+    if (found == chunks.end()) {
+        ENGINE_LOG_EVERY_MS(DEBUG, 1000) << "Did not find Chunk at coords " << xInd * EngineConstants::CHUNK_WIDTH
+                                         << " " << zInd * EngineConstants::CHUNK_LENGTH;
         return {};
     } else {
-        return chunks[findKey];
+        return found->second;
     }
 }
 
@@ -153,6 +139,61 @@ size_t ChunkManager::getNumberOfEntities() const {
     return total;
 }
 
+uint64_t ChunkManager::computeHash() const {
+    uint64_t hash = 0;
+    for (const auto &chunk : chunks) {
+        for (const auto &entity : chunk.second->getEntities()) {
+            const glm::vec3 &position = entity.second->getTransform().getPosition();
+            uint32_t bits[3];
+            std::memcpy(bits, &position[0], sizeof(bits));
+
+            // summed, so the hash doesn't depend on the iteration order
+            uint64_t blockHash = hashCombine(entity.second->getBlockID(), bits[0]);
+            blockHash = hashCombine(blockHash, bits[1]);
+            hash += hashCombine(blockHash, bits[2]);
+        }
+    }
+    return hash;
+}
+
+// red-black tree nodes hold three pointers and a color next to their value, and make_shared puts the reference counts
+// and a vtable pointer in front of the object
+static constexpr size_t MAP_NODE_OVERHEAD = 4 * sizeof(void *);
+static constexpr size_t CONTROL_BLOCK_SIZE = 2 * sizeof(int) + sizeof(void *);
+
+void ChunkManager::measureMemory() const {
+    int64_t entityBytes = 0, indexBytes = 0, meshBytes = 0, entityCount = 0;
+
+    indexBytes += static_cast<int64_t>(chunks.size() * (MAP_NODE_OVERHEAD + sizeof(*chunks.begin()) +
+                                                        CONTROL_BLOCK_SIZE + sizeof(Chunk)));
+    for (const auto &chunk : chunks) {
+        size_t entities = chunk.second->getEntities().size();
+        entityCount += static_cast<int64_t>(entities);
+        entityBytes += static_cast<int64_t>(entities * (CONTROL_BLOCK_SIZE + sizeof(Entity)));
+        indexBytes += static_cast<int64_t>(entities * (MAP_NODE_OVERHEAD +
+                                                       sizeof(std::pair<const EntityID, std::shared_ptr<Entity>>)));
+
+        for (const auto &blockType : chunk.second->getEntitiesByBlockID()) {
+            indexBytes += static_cast<int64_t>(MAP_NODE_OVERHEAD + sizeof(blockType) +
+                                               blockType.second.capacity() * sizeof(std::shared_ptr<Entity>));
+        }
+        meshBytes += static_cast<int64_t>(chunk.second->getMesh().getCpuBytes());
+    }
+
+    MemoryStats::set(WORLD_ENTITIES, entityBytes, entityCount);
+    MemoryStats::set(WORLD_INDICES, indexBytes, entityCount);
+    MemoryStats::set(CHUNK_MESHES_CPU, meshBytes, static_cast<int64_t>(chunks.size()));
+}
+
+std::vector<std::shared_ptr<Chunk>> ChunkManager::getChunks() const {
+    std::vector<std::shared_ptr<Chunk>> out;
+    out.reserve(chunks.size());
+    for (const auto &chunk : chunks) {
+        out.push_back(chunk.second);
+    }
+    return out;
+}
+
 int WorldInfo::generateSeed() {
     std::random_device rd;
     std::mt19937 mt(rd());
@@ -182,8 +223,8 @@ bool ChunkManager::removeEntityFromChunk(Entity &entity) {
     if (optChunk.has_value()) {
         return (*optChunk)->removeEntityByID(entity.getEntityID());
     } else {
-        LOG(DEBUG) << "Could not find chunk for entity at " << entity.getTransform().getPosition().x << " "
-                   << entity.getTransform().getPosition().y << " " << entity.getTransform().getPosition().z;
+        ENGINE_LOG(DEBUG) << "Could not find chunk for entity at " << entity.getTransform().getPosition().x << " "
+                          << entity.getTransform().getPosition().y << " " << entity.getTransform().getPosition().z;
         return false;
     }
 }
@@ -2,12 +2,25 @@
 // Created by Willi on 7/30/2020.
 //
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iterator>
+#include <random>
+#include <unordered_map>
 #include <vector>
 #include <glm/ext.hpp>
-#include <thread>
 #include "../libs/easylogging++.h"
 #include "../libs/FastNoise.h"
 #include "../include/engine.h"
+#include "../include/logging.h"
+#include "../include/memory_stats.h"
+#include "../include/profiler.h"
+#include "../include/render_stats.h"
+#include "../include/startup_report.h"
+#include "../include/texture_uploader.h"
 
 Engine::Engine(Config config) {
 
@@ -15,19 +28,38 @@ Engine::Engine(Config config) {
     //do some processing based on config
     LOG(INFO) << "Config {windowHeight=" << config.windowHeight << ", windowWidth=" << config.windowWidth << ", fov="
               << config.fov << "}";
+    // a replay recreates the world the recording was made in, and always runs headless
+    if (!config.replayPath.empty()) {
+        if (input.startReplay(config.replayPath)) {
+            config.seed = input.getReplayHeader().seed;
+            config.worldSize = static_cast<int>(input.getReplayHeader().worldSize);
+            config.frames = input.getReplayHeader().tickCount;
+        }
+        config.headless = true;
+    }
+
     this->config = config;
     this->worldInfo = WorldInfo(config);
 
     this->windowWidth = config.windowWidth;
     this->windowHeight = config.windowHeight;
 
+    this->jobSystem = std::make_unique<JobSystem>();
+
     LOG(INFO) << "Initializing GLFW ...";
 
-    // Initialize GLFW
-    glfwInit();
-    this->
-            window = glfwCreateWindow(config.windowWidth, config.windowHeight, "COMP 371 Final Project", nullptr,
-                                      nullptr);
+    if (config.headless) {
+        if (!createHeadlessContext()) {
+            LOG(WARNING) << "No offscreen OpenGL context is available, running headless without rendering.";
+            return;
+        }
+    } else {
+        // Initialize GLFW
+        glfwInit();
+        this->
+                window = glfwCreateWindow(config.windowWidth, config.windowHeight, "COMP 371 Final Project", nullptr,
+                                          nullptr);
+    }
     glfwSetWindowUserPointer(window, this);
 
     if (window == nullptr) {
@@ -41,6 +73,8 @@ Engine::Engine(Config config) {
     auto keyCallback = [](GLFWwindow *windowParam, int key, int scancode, int action, int mods) {
         if (key == GLFW_KEY_ESCAPE && action == GLFW_PRESS)
             glfwSetWindowShouldClose(windowParam, true);
+        if (key == GLFW_KEY_F3 && action == GLFW_PRESS)
+            static_cast<Engine *>(glfwGetWindowUserPointer(windowParam))->memoryReportRequested = true;
     };
     auto framebufferSizeCallback = [](GLFWwindow *windowParam, int width, int height) {
         glViewport(0, 0, width, height);
@@ -53,9 +87,10 @@ Engine::Engine(Config config) {
     glfwSetFramebufferSizeCallback(window, framebufferSizeCallback);
     glfwSetErrorCallback(errorCallback);
 
-    glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
+    if (!config.headless)
+        glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
 
-    glEnable(GL_DEPTH_TEST);
+    GLStateCache::setCapability(GL_DEPTH_TEST, true);
 
     LOG(INFO) << "Initializing GLEW ...";
 
@@ -72,7 +107,80 @@ Engine::Engine(Config config) {
     glGetIntegerv(GL_MINOR_VERSION, &glMinor);
     LOG(INFO) << "Using OpenGL version " << glMajor << "." << glMinor << ".";
     LOG(INFO) << "Successfully initialized GLEW version " << glewGetString(GLEW_VERSION) << ".";
+    this->glContext = true;
+}
+
+void Engine::startShaders() {
+    // headless runs don't draw
+    if (!glContext || config.headless)
+        return;
+    StartupStage stage("shaders");
+    bool parallel = Shader::enableParallelCompile();
+    LOG(INFO) << "Compiling shaders " << (parallel ? "on the driver's threads." : "(no parallel shader compile).");
+
+    shaders.basic = std::make_unique<Shader>("shaders/ModelVertexShader.glsl", "shaders/ModelFragmentShader.glsl",
+                                             nullptr, false);
+    shaders.light = std::make_unique<Shader>("shaders/BasicLightingVertexShader.glsl",
+                                             "shaders/BasicLightingFragmentShader.glsl", nullptr, false);
+    shaders.sun = std::make_unique<Shader>("shaders/LightCubeVertexShader.glsl",
+                                           "shaders/LightCubeFragmentShader.glsl", nullptr, false);
+    shaders.skybox = std::make_unique<Shader>("shaders/SkyboxVertexShader.glsl",
+                                              "shaders/SkyboxFragmentShader.glsl", nullptr, false);
+}
+
+void Engine::finishShaders() {
+    StartupStage stage("shaderLink");
+    Shader *all[] = {shaders.basic.get(), shaders.light.get(), shaders.sun.get(), shaders.skybox.get()};
+    unsigned int ready = 0;
+    for (Shader *shader : all) {
+        if (shader->isReady())
+            ready++;
+        shader->finish();
+    }
+    LOG(INFO) << ready << " of " << std::size(all) << " shaders were linked by the time the first frame needed them.";
+
+    // sampler units never change, so they're set once instead of per draw
+    shaders.light->use();
+    shaders.light->setInt("texture2D", 0);
+    shaders.light->setInt("textureCubeMap", 1);
+    shaders.basic->use();
+    shaders.basic->setInt("texture2D", 0);
+    shaders.basic->setInt("textureCubeMap", 1);
+    shaders.skybox->use();
+    shaders.skybox->setInt("skybox", 1);
+}
+
+bool Engine::createHeadlessContext() {
+
+    // a hidden window still gets a hardware or Mesa context wherever there is a display server, i.e. Xvfb on CI
+    if (glfwInit()) {
+        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+        this->window = glfwCreateWindow(config.windowWidth, config.windowHeight, "COMP 371 Final Project", nullptr,
+                                        nullptr);
+        if (window != nullptr) {
+            LOG(INFO) << "Created a hidden window for the offscreen context.";
+            return true;
+        }
+        glfwTerminate();
+    }
+
+#ifdef GLFW_PLATFORM_NULL
+    // GLFW 3.4+ can also run without any display server and render through OSMesa, if the library is installed
+    glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+    if (glfwInit()) {
+        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+        glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_OSMESA_CONTEXT_API);
+        this->window = glfwCreateWindow(config.windowWidth, config.windowHeight, "COMP 371 Final Project", nullptr,
+                                        nullptr);
+        if (window != nullptr) {
+            LOG(INFO) << "Created an OSMesa context on the null platform.";
+            return true;
+        }
+        glfwTerminate();
+    }
+#endif
 
+    return false;
 }
 
 void Engine::init() {
@@ -81,7 +189,12 @@ void Engine::init() {
     this->chunkManager = std::make_unique<ChunkManager>(this->worldInfo);
 
     LOG(INFO) << "Inserting Entities into the World ...";
-    generateWorld();
+    {
+        StartupStage stage("worldGeneration");
+        auto generationStart = FrameStats::now();
+        generateWorld();
+        this->worldGenerationMs = FrameStats::elapsedMs(generationStart);
+    }
 
     LOG(INFO) << "Number of entities: " << this->chunkManager->getNumberOfEntities();
     LOG(INFO) << "Number of Chunks: " << this->chunkManager->getNumberOfChunks();
@@ -98,27 +211,29 @@ void Engine::init() {
     sun->getTransform().setPosition(glm::vec3(this->worldInfo.getWidth() / 2, 45.0f,
                                               this->worldInfo.getLength() / 2));
 
+    // headless runs bake the chunks as the camera reaches them, so that mesh building is part of what they measure
+    if (glContext)
+        chunkRenderer = std::make_unique<ChunkRenderer>(*jobSystem);
+    if (!config.headless) {
+        LOG(INFO) << "Building chunk meshes ...";
+        StartupStage stage("chunkMeshes");
+        chunkRenderer->rebuildChunks(chunkManager->getChunks());
+    }
+
     LOG(INFO) << "Engine is primed and ready.";
 }
 
 void Engine::runLoop() {
 
-    //TODO should this be here?
-    Shader basicShader = Shader((fs::current_path().string() + "/resources/shaders/ModelVertexShader.glsl").c_str(),
-                                (fs::current_path().string() + "/resources/shaders/ModelFragmentShader.glsl").c_str());
-    Shader lightShader = Shader(
-            (fs::current_path().string() + "/resources/shaders/BasicLightingVertexShader.glsl").c_str(),
-            (fs::current_path().string() + "/resources/shaders/BasicLightingFragmentShader.glsl").c_str());
-
-    Shader sunShader = Shader((fs::current_path().string() + "/resources/shaders/LightCubeVertexShader.glsl").c_str(),
-                              (fs::current_path().string() +
-                               "/resources/shaders/LightCubeFragmentShader.glsl").c_str());
-
-    Shader skyboxShader = Shader((fs::current_path().string() + "/resources/shaders/SkyboxVertexShader.glsl").c_str(),
-                                 (fs::current_path().string() +
-                                  "/resources/shaders/SkyboxFragmentShader.glsl").c_str());
+    // main started the shaders right after creating the engine, only now is their link status needed
+    finishShaders();
+    Shader &basicShader = *shaders.basic;
+    Shader &lightShader = *shaders.light;
+    Shader &sunShader = *shaders.sun;
+    Shader &skyboxShader = *shaders.skybox;
 
     ViewFrustum frustum = ViewFrustum();
+    RenderQueue renderQueue = RenderQueue();
     // ***********
 
     glfwSwapInterval(1);
@@ -126,84 +241,375 @@ void Engine::runLoop() {
     double t = 0.0f;
     double dt = 1.0f / 30.0f; // 1s per 30frames
     double tickRate = 1000.0 / 30.0;
-    double currentTime = glfwGetTime();
-
-    double lastTime = glfwGetTime();
-    int nbFrames = 0;
 
-    glEnable(GL_CULL_FACE);
+    GLStateCache::setCapability(GL_CULL_FACE, true);
     glCullFace(GL_BACK);
     glFrontFace(GL_CW);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
     SoundDatabase::playSoundByName("calm.mp3", true);
 
+    if (!config.recordPath.empty())
+        input.startRecording(config.recordPath);
+    RenderStats::setLogInterval(config.renderStatsInterval);
+
     // Render loop
     while (!glfwWindowShouldClose(window)) {
 
-        double newTime = glfwGetTime();
-        double frameTime = (newTime - currentTime) * 1000.0f; // in ms
-        currentTime = newTime;
+        PROFILE_SCOPE("Frame");
+        GLStateCache::beginFrame();
+        RenderStats::beginFrame();
+
+        auto frameStart = FrameStats::now();
+
+        if (memoryReportRequested) {
+            reportMemory(false);
+            memoryReportRequested = false;
+        }
+
+        {
+            // finish the GL side of the work done in the background, i.e. uploading rebuilt chunk meshes
+            PROFILE_SCOPE("Main thread jobs");
+            jobSystem->runMainThreadJobs();
+        }
 
         // per-frame time logic
         // --------------------
-        player->processInput(this);
-        player->update(this, static_cast<float>(dt));
+        {
+            PROFILE_SCOPE("Simulation");
+            auto simulationStart = FrameStats::now();
+            input.beginTick(window);
+            player->look(input.getMouseDeltaX(), input.getMouseDeltaY());
+            player->processInput(this);
+            player->update(this, static_cast<float>(dt));
+            frameStats.record(SIMULATION_TIME, FrameStats::elapsedMs(simulationStart));
+        }
         // --------------------
 
         glClearColor(0.2f, 0.3f, 0.3f, 1.0f);
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
         glm::mat4 projection = glm::perspective(glm::radians(config.fov), (float) windowWidth / (float) windowHeight,
-                                                0.1f, 96.0f);
+                                                EngineConstants::NEAR_PLANE, EngineConstants::FAR_PLANE);
+        glm::mat4 view = player->getPlayerView();
+        frustum.update(projection, view);
 
         // rendering stuff here
         // --------------------
         lightShader.use();
-        lightShader.setMat4("view", player->getPlayerView());
+        lightShader.setMat4("view", view);
         lightShader.setMat4("projection", projection);
         lightShader.setVec3("lightPos", sun->getTransform().getPosition());
         lightShader.setVec3("viewPos", player->camera.Position);
 
-        auto chunksToDraw = chunkManager->getSurroundingChunksByXZ(
-                {player->getTransform().getPosition().x, player->getTransform().getPosition().z});
-        LOG(DEBUG) << "Rendering " << chunksToDraw.size() << " Chunks.";
-        for (const auto &chunk : chunksToDraw) {
-            chunk->renderChunk(lightShader, frustum);
-        }
-
         basicShader.use();
-        basicShader.setMat4("view", player->getPlayerView());
+        basicShader.setMat4("view", view);
         basicShader.setMat4("projection", projection);
-        player->draw(basicShader);
 
         skyboxShader.use();
-        skyboxShader.setMat4("view", glm::mat4(glm::mat3(player->getPlayerView())));
+        skyboxShader.setMat4("view", glm::mat4(glm::mat3(view)));
         skyboxShader.setMat4("projection", projection);
 
-        glDisable(GL_CULL_FACE);
-        skybox->draw(skyboxShader);
-        glEnable(GL_CULL_FACE);
-
         sunShader.use();
-        sunShader.setMat4("view", player->getPlayerView());
+        sunShader.setMat4("view", view);
         sunShader.setMat4("projection", projection);
 
         sun->update(static_cast<float>(dt));
-        sun->draw(sunShader);
+
+        renderQueue.clear();
+        auto submitStart = FrameStats::now();
+
+        {
+            PROFILE_SCOPE("Cull and submit");
+            auto chunksToDraw = chunkManager->getSurroundingChunksByXZ(
+                    {player->getTransform().getPosition().x, player->getTransform().getPosition().z});
+            ENGINE_LOG(TRACE) << "Rendering " << chunksToDraw.size() << " Chunks.";
+            chunkRenderer->beginFrame();
+            for (const auto &chunk : chunksToDraw) {
+                chunkRenderer->addChunk(*chunk, frustum, player->camera.Position);
+            }
+            chunkRenderer->submit(renderQueue, lightShader);
+
+            player->submit(renderQueue, OPAQUE_PASS, basicShader, player->camera.Position);
+            sun->submit(renderQueue, OPAQUE_PASS, sunShader, player->camera.Position);
+            skybox->submit(renderQueue, skyboxShader);
+        }
+
+        {
+            PROFILE_SCOPE("Sort draws");
+            renderQueue.sort();
+        }
+        {
+            PROFILE_SCOPE("Execute draws");
+            renderQueue.execute();
+        }
+        frameStats.record(SUBMIT_TIME, FrameStats::elapsedMs(submitStart));
+        frameStats.record(CPU_TIME, FrameStats::elapsedMs(frameStart));
 
         // --------------------
 
-        glfwSwapBuffers(window);
-        glfwPollEvents();
+        {
+            PROFILE_SCOPE("Swap buffers");
+            auto swapStart = FrameStats::now();
+            glfwSwapBuffers(window);
+            glfwPollEvents();
+            frameStats.record(SWAP_TIME, FrameStats::elapsedMs(swapStart));
+        }
+        TextureUploader::flush();
+        TextureDatabase::update();
+        ModelDatabase::update();
+        SoundDatabase::update();
+
+        if (!StartupReport::hasFirstFrame()) {
+            StartupReport::markFirstFrame();
+            StartupReport::logSummary();
+            StartupReport::write(config.startupReportPath);
+        }
+
+        frameStats.record(FRAME_TIME, FrameStats::elapsedMs(frameStart));
+        frameStats.endFrame();
     }
 
+    frameStats.writeReport(EngineConstants::FRAME_STATS_PATH);
+    reportMemory(true);
+    if (!config.recordPath.empty())
+        input.finishRecording({worldInfo.getSeed(), worldInfo.getWidth(), 0, computeWorldHash()});
+    destroyContext();
+}
+
+void Engine::destroyContext() {
+    // the GL objects are deleted while the context they belong to is still current
+    chunkRenderer.reset();
+    ModelDatabase::destroy();
+    TextureDatabase::destroy();
+    TextureUploader::destroy();
     glfwTerminate();
 }
 
+/// Position of the headless camera at the given angle, on a circle around the middle of the world
+static glm::vec3 headlessCameraPosition(const WorldInfo &worldInfo, float angle) {
+    glm::vec2 center(worldInfo.getWidth() / 2.0f, worldInfo.getLength() / 2.0f);
+    float radius = 0.35f * static_cast<float>(std::min(worldInfo.getWidth(), worldInfo.getLength()));
+    return {center.x + radius * std::cos(angle), EngineConstants::HEADLESS_CAMERA_HEIGHT,
+            center.y + radius * std::sin(angle)};
+}
+
+void Engine::runHeadless() {
+
+    LOG(INFO) << (input.isReplaying() ? "Replaying the recorded input for " : "Flying the camera path for ")
+              << config.frames << " frames " << (glContext ? "with an offscreen OpenGL context." : "without OpenGL.");
+
+    ViewFrustum frustum = ViewFrustum();
+    glm::mat4 projection = glm::perspective(glm::radians(config.fov), (float) windowWidth / (float) windowHeight,
+                                            EngineConstants::NEAR_PLANE, EngineConstants::FAR_PLANE);
+    float dt = 1.0f / 30.0f;
+
+    // without a GL context the meshes are only baked, so their bounds are kept here to cull them
+    std::unordered_map<const Chunk *, std::pair<glm::vec3, glm::vec3>> bakedBounds;
+    HeadlessTotals totals{};
+    auto runStart = FrameStats::now();
+
+    RenderStats::setLogInterval(config.renderStatsInterval);
+    for (unsigned int frame = 0; frame < config.frames; frame++) {
+
+        PROFILE_SCOPE("Frame");
+        RenderStats::beginFrame();
+        auto frameStart = FrameStats::now();
+
+        if (glContext) {
+            PROFILE_SCOPE("Main thread jobs");
+            jobSystem->runMainThreadJobs();
+        }
+
+        {
+            PROFILE_SCOPE("Simulation");
+            auto simulationStart = FrameStats::now();
+            if (input.isReplaying()) {
+                // the same tick as in runLoop, fed by the recording
+                input.beginTick(nullptr);
+                player->look(input.getMouseDeltaX(), input.getMouseDeltaY());
+                player->processInput(this);
+                player->update(this, dt);
+            } else {
+                // the player is moved along the path, then ticked so that its physics and collisions still run
+                float angle = glm::two_pi<float>() * static_cast<float>(frame) / static_cast<float>(config.frames);
+                player->setPosition(headlessCameraPosition(worldInfo, angle));
+                player->update(this, dt);
+                player->camera.Yaw = glm::degrees(angle) + 90.0f; // along the circle
+                player->camera.Pitch = EngineConstants::HEADLESS_CAMERA_PITCH;
+                player->camera.updateCameraVectors();
+            }
+            sun->update(dt);
+            frameStats.record(SIMULATION_TIME, FrameStats::elapsedMs(simulationStart));
+        }
+
+        auto submitStart = FrameStats::now();
+        frustum.update(projection, player->getPlayerView());
+        auto chunksToDraw = chunkManager->getSurroundingChunksByXZ(
+                {player->getTransform().getPosition().x, player->getTransform().getPosition().z});
+
+        {
+            PROFILE_SCOPE("Build meshes");
+            std::vector<std::shared_ptr<Chunk>> dirtyChunks;
+            for (const auto &chunk : chunksToDraw) {
+                if (chunk->isMeshDirty())
+                    dirtyChunks.push_back(chunk);
+            }
+
+            if (glContext) {
+                chunkRenderer->rebuildChunks(dirtyChunks);
+            } else if (!dirtyChunks.empty()) {
+                std::vector<ChunkMeshData> meshes(dirtyChunks.size());
+                auto chunkCount = static_cast<unsigned int>(dirtyChunks.size());
+                jobSystem->wait(jobSystem->parallelFor(0, chunkCount, 1, [&](unsigned int first, unsigned int last) {
+                    for (unsigned int i = first; i < last; i++)
+                        meshes[i] = bakeChunkMesh(dirtyChunks[i]->getEntitiesByBlockID());
+                }));
+                for (size_t i = 0; i < dirtyChunks.size(); i++) {
+                    if (!meshes[i].indices.empty())
+                        bakedBounds[dirtyChunks[i].get()] = {meshes[i].boundsMin, meshes[i].boundsMax};
+                    dirtyChunks[i]->setMeshDirty(false);
+                }
+            }
+            totals.chunksBaked += dirtyChunks.size();
+        }
+
+        {
+            PROFILE_SCOPE("Cull");
+            unsigned int visible = 0;
+            if (glContext) {
+                chunkRenderer->beginFrame();
+                for (const auto &chunk : chunksToDraw) {
+                    chunkRenderer->addChunk(*chunk, frustum, player->camera.Position);
+                }
+                visible = chunkRenderer->getVisibleChunkCount();
+            } else {
+                for (const auto &chunk : chunksToDraw) {
+                    auto bounds = bakedBounds.find(chunk.get());
+                    if (bounds != bakedBounds.end() &&
+                        frustum.isBoxInFrustum(bounds->second.first,
+                                               BoundingBox(bounds->second.second - bounds->second.first)))
+                        visible++;
+                }
+            }
+            totals.visibleChunks += visible;
+            totals.culledChunks += chunksToDraw.size() - visible;
+        }
+
+        frameStats.record(SUBMIT_TIME, FrameStats::elapsedMs(submitStart));
+        frameStats.record(CPU_TIME, FrameStats::elapsedMs(frameStart));
+        frameStats.record(FRAME_TIME, FrameStats::elapsedMs(frameStart));
+        frameStats.endFrame();
+        totals.frames++;
+        if (glContext) {
+            TextureUploader::flush();
+            TextureDatabase::update();
+            ModelDatabase::update();
+        }
+
+        if (!StartupReport::hasFirstFrame()) {
+            StartupReport::markFirstFrame();
+            StartupReport::logSummary();
+            StartupReport::write(config.startupReportPath);
+        }
+    }
+
+    totals.totalMs = FrameStats::elapsedMs(runStart);
+    totals.worldHash = computeWorldHash();
+    if (input.isReplaying()) {
+        if (totals.worldHash == input.getReplayHeader().worldHash) {
+            LOG(INFO) << "The replay ended in the same world state as the recording.";
+        } else {
+            LOG(WARNING) << "The replay ended in a different world state than the recording (hash " << std::hex
+                         << totals.worldHash << " instead of " << input.getReplayHeader().worldHash << std::dec
+                         << ").";
+        }
+    }
+    writeHeadlessReport(totals);
+    reportMemory(true);
+
+    if (glContext)
+        destroyContext();
+}
+
+void Engine::writeHeadlessReport(const HeadlessTotals &totals) const {
+
+    std::ofstream file(config.reportPath);
+    if (!file.is_open()) {
+        LOG(WARNING) << "Could not open " << config.reportPath << " to write the headless report.";
+        return;
+    }
+
+    file << std::fixed << std::setprecision(4);
+    file << "{\n";
+    file << "  \"build\": \"" << __DATE__ << " " << __TIME__ << "\",\n";
+    file << "  \"glContext\": " << (glContext ? "true" : "false") << ",\n";
+    file << "  \"seed\": " << worldInfo.getSeed() << ",\n";
+    file << "  \"worldWidth\": " << worldInfo.getWidth() << ",\n";
+    file << "  \"worldLength\": " << worldInfo.getLength() << ",\n";
+    file << "  \"chunks\": " << chunkManager->getNumberOfChunks() << ",\n";
+    file << "  \"entities\": " << chunkManager->getNumberOfEntities() << ",\n";
+    file << "  \"worldGenerationMs\": " << worldGenerationMs << ",\n";
+    file << "  \"frames\": " << totals.frames << ",\n";
+    file << "  \"totalMs\": " << totals.totalMs << ",\n";
+    file << "  \"chunksBaked\": " << totals.chunksBaked << ",\n";
+    file << "  \"visibleChunks\": " << totals.visibleChunks << ",\n";
+    file << "  \"culledChunks\": " << totals.culledChunks << ",\n";
+    file << "  \"hitches\": " << frameStats.getHitchCount() << ",\n";
+    file << "  \"worldHash\": \"" << std::hex << totals.worldHash << std::dec << "\",\n";
+    if (input.isReplaying()) {
+        file << "  \"replayMatchesRecording\": "
+             << (totals.worldHash == input.getReplayHeader().worldHash ? "true" : "false") << ",\n";
+    }
+    file << "  \"metrics\": ";
+    frameStats.writeMetrics(file, "  ");
+    file << "\n}\n";
+
+    LOG(INFO) << "Wrote the headless report to " << config.reportPath << ".";
+}
+
 // glfw: whenever the mouse moves, this callback is called
 // -------------------------------------------------------
 void Engine::mouseCallbackFunc(GLFWwindow *windowParam, double xpos, double ypos) {
-    player->look(windowParam, xpos, ypos);
+    input.addCursorPosition(xpos, ypos);
+}
+
+uint64_t Engine::computeWorldHash() const {
+    // the player is part of the state, its position depends on every tick of input
+    const glm::vec3 &position = player->getTransform().getPosition();
+    uint32_t bits[3];
+    std::memcpy(bits, &position[0], sizeof(bits));
+
+    uint64_t hash = chunkManager->computeHash();
+    for (uint32_t component : bits) {
+        hash = hashCombine(hash, component);
+    }
+    return hash;
+}
+
+void Engine::reportMemory(bool writeFile) const {
+    chunkManager->measureMemory();
+    if (chunkRenderer) {
+        BufferArenaStats arenaStats = chunkRenderer->getArenaStats();
+        MemoryStats::set(CHUNK_MESHES_GPU, arenaStats.bytesInUse, arenaStats.allocationCount);
+    }
+    SoundDatabase::measureMemory();
+
+    if (config.lazyAssets) {
+        const std::pair<const char *, AssetResidencyStats> residencies[] = {
+                {"Textures", TextureDatabase::getResidencyStats()},
+                {"Models", ModelDatabase::getResidencyStats()},
+                {"Sounds", SoundDatabase::getResidencyStats()}};
+        for (const auto &residency : residencies) {
+            LOG(INFO) << residency.first << ": " << residency.second.residentCount << " resident ("
+                      << residency.second.residentBytes / 1024 << " KiB), " << residency.second.loads << " loads, "
+                      << residency.second.evictions << " evictions.";
+        }
+    }
+
+    MemoryStats::logBreakdown();
+    if (writeFile)
+        MemoryStats::writeReport(EngineConstants::MEMORY_REPORT_PATH);
 }
 
 //TODO: Is there some way to add randomness to trees?
@@ -240,63 +646,81 @@ void Engine::addTree(unsigned int x, unsigned int y, unsigned int z) const {
 }
 
 
-void Engine::generateWorld() {
+void Engine::generateColumn(const FastNoise &noiseGen, unsigned int x, unsigned int z) const {
 
-    auto noiseGen = FastNoise(worldInfo.getSeed());
-    noiseGen.SetNoiseType(FastNoise::Simplex);
+    float tempHeight = noiseGen.GetNoise(x, 0, z) + 1;
+    int height = static_cast<int>(round((tempHeight * 10) + 1)) + 10;
 
-    for (unsigned int x = 0; x < this->worldInfo.getWidth(); x++) {
-        for (unsigned int z = 0; z < this->worldInfo.getLength(); z++) {
-            float tempHeight = noiseGen.GetNoise(x, 0, z) + 1;
-            int height = static_cast<int>(round((tempHeight * 10) + 1)) + 10;
+    auto chunk = this->chunkManager->getChunkByXZ({x, z});
 
-            auto chunk = this->chunkManager->getChunkByXZ({x, z});
+    if (height < 14) {
+        height = 13;
+        (*chunk)->addEntity(
+                Entity(ModelType::CUBE, BlockID::STONE, Transform({x, height - 1, z}, {1, 1, 1}, {0, 0, 0})));
+        (*chunk)->addEntity(
+                Entity(ModelType::CUBE, BlockID::WATER, Transform({x, height, z}, {1, 1, 1}, {0, 0, 0})));
 
-            if (height < 14) {
-                height = 13;
+        for (int i = height - 2; i >= 0; i--) {
+            if (i > 0) {
                 (*chunk)->addEntity(
-                        Entity(ModelType::CUBE, BlockID::STONE, Transform({x, height - 1, z}, {1, 1, 1}, {0, 0, 0})));
+                        Entity(ModelType::CUBE, BlockID::STONE, Transform({x, i, z}, {1, 1, 1}, {0, 0, 0})));
+            } else {
                 (*chunk)->addEntity(
-                        Entity(ModelType::CUBE, BlockID::WATER, Transform({x, height, z}, {1, 1, 1}, {0, 0, 0})));
-
-                for (int i = height - 2; i >= 0; i--) {
-                    if (i > 0) {
-                        (*chunk)->addEntity(
-                                Entity(ModelType::CUBE, BlockID::STONE, Transform({x, i, z}, {1, 1, 1}, {0, 0, 0})));
-                    } else {
-                        (*chunk)->addEntity(
-                                Entity(ModelType::CUBE, BlockID::BEDROCK, Transform({x, i, z}, {1, 1, 1}, {0, 0, 0})));
-                    }
-                }
+                        Entity(ModelType::CUBE, BlockID::BEDROCK, Transform({x, i, z}, {1, 1, 1}, {0, 0, 0})));
+            }
+        }
+    } else {
+        (*chunk)->addEntity(
+                Entity(ModelType::CUBE, BlockID::DIRT_GRASS, Transform({x, height, z}, {1, 1, 1}, {0, 0, 0})));
+
+        int tree = (x * height * z) ^worldInfo.getSeed();
+        if (tree % 61 == 0) {
+            addTree(x, height, z);
+        }
+
+        for (int i = height - 1; i >= 0; i--) {
+            if (i >= 8) {
+                (*chunk)->addEntity(
+                        Entity(ModelType::CUBE, BlockID::DIRT, Transform({x, i, z}, {1, 1, 1}, {0, 0, 0})));
+            } else if (i > 0) {
+                (*chunk)->addEntity(
+                        Entity(ModelType::CUBE, BlockID::STONE, Transform({x, i, z}, {1, 1, 1}, {0, 0, 0})));
             } else {
                 (*chunk)->addEntity(
-                        Entity(ModelType::CUBE, BlockID::DIRT_GRASS, Transform({x, height, z}, {1, 1, 1}, {0, 0, 0})));
+                        Entity(ModelType::CUBE, BlockID::BEDROCK, Transform({x, i, z}, {1, 1, 1}, {0, 0, 0})));
+            }
+        }
+    }
+}
 
-                int tree = (x * height * z) ^worldInfo.getSeed();
-                if (tree % 61 == 0) {
-                    addTree(x, height, z);
-                }
+void Engine::generateWorld() {
+    PROFILE_FUNCTION();
 
-                for (int i = height - 1; i >= 0; i--) {
-                    if (i >= 8) {
-                        (*chunk)->addEntity(
-                                Entity(ModelType::CUBE, BlockID::DIRT, Transform({x, i, z}, {1, 1, 1}, {0, 0, 0})));
-                    } else if (i > 0) {
-                        (*chunk)->addEntity(
-                                Entity(ModelType::CUBE, BlockID::STONE, Transform({x, i, z}, {1, 1, 1}, {0, 0, 0})));
-                    } else {
-                        (*chunk)->addEntity(
-                                Entity(ModelType::CUBE, BlockID::BEDROCK, Transform({x, i, z}, {1, 1, 1}, {0, 0, 0})));
-                    }
+    auto noiseGen = FastNoise(worldInfo.getSeed());
+    noiseGen.SetNoiseType(FastNoise::Simplex);
+
+    // chunks are independent of each other, so each one is filled by its own job
+    unsigned int chunksX = this->worldInfo.getWidth() / EngineConstants::CHUNK_WIDTH;
+    unsigned int chunksZ = this->worldInfo.getLength() / EngineConstants::CHUNK_LENGTH;
+    jobSystem->wait(jobSystem->parallelFor(0, chunksX * chunksZ, 1, [&](unsigned int first, unsigned int last) {
+        for (unsigned int chunkIndex = first; chunkIndex < last; chunkIndex++) {
+            PROFILE_SCOPE("Generate chunk");
+            unsigned int originX = (chunkIndex / chunksZ) * EngineConstants::CHUNK_WIDTH;
+            unsigned int originZ = (chunkIndex % chunksZ) * EngineConstants::CHUNK_LENGTH;
+            for (unsigned int x = originX; x < originX + EngineConstants::CHUNK_WIDTH; x++) {
+                for (unsigned int z = originZ; z < originZ + EngineConstants::CHUNK_LENGTH; z++) {
+                    generateColumn(noiseGen, x, z);
                 }
             }
         }
-    }
+    }));
 
+    // seeded, so the same seed always places the letters at the same spots
+    std::mt19937 random(static_cast<std::mt19937::result_type>(worldInfo.getSeed()));
     for (unsigned int j = 0; j < 5; j++) {
         while (true) {
-            int x = (rand() % 32) + static_cast<int>(this->worldInfo.getWidth()) / 2;
-            int z = (rand() % 32) + static_cast<int>(this->worldInfo.getLength()) / 2;
+            int x = static_cast<int>(random() % 32) + static_cast<int>(this->worldInfo.getWidth()) / 2;
+            int z = static_cast<int>(random() % 32) + static_cast<int>(this->worldInfo.getLength()) / 2;
             int height[6];
             for (unsigned int i = 0; i < 6; i++) {
                 height[i] = static_cast<int>(round(((noiseGen.GetNoise(x + i, 0, z) + 1) * 10.0f) + 1.0f) + 10.0f);
@@ -2,8 +2,9 @@
 // Created by Willi on 8/5/2020.
 //
 #include "../include/entity.h"
+#include "../include/engine_constants.h"
 
-EntityID Entity::entityIDCounter = 1;
+std::atomic<EntityID> Entity::entityIDCounter{1};
 
 Entity::Entity(std::string modelName, BlockID blockId) {
     this->modelName = std::move(modelName);
@@ -11,8 +12,7 @@ Entity::Entity(std::string modelName, BlockID blockId) {
     this->transform = Transform();
     this->box = BoundingBox({1.0, 1.0, 1.0});
     this->entityID = Entity::entityIDCounter++;
-    this->tex = TextureDatabase::getTextureByBlockId(this->blockId);
-    this->model = ModelDatabase::getModelByName(this->modelName);
+    this->modelIndex = ModelDatabase::getModelIndex(this->modelName);
 }
 
 Entity::Entity(std::string modelName, BlockID blockId1, Transform transform1) {
@@ -21,44 +21,34 @@ Entity::Entity(std::string modelName, BlockID blockId1, Transform transform1) {
     this->transform = transform1;
     this->box = BoundingBox({1.0, 1.0, 1.0});
     this->entityID = Entity::entityIDCounter++;
-    this->tex = TextureDatabase::getTextureByBlockId(this->blockId);
-    this->model = ModelDatabase::getModelByName(this->modelName);
+    this->modelIndex = ModelDatabase::getModelIndex(this->modelName);
 }
 
-void Entity::draw(Shader &shader) {
+void Entity::submit(RenderQueue &queue, RenderPass pass, Shader &shader, const glm::vec3 &viewPos) {
 
-    shader.setMat4("model", this->transform.getModelMatrix());
+    glm::vec3 center = this->transform.getPosition() + this->box.dimensions * 0.5f;
 
-    // Get Model through ModelDatabase and draw
-    this->model->draw();
+    // Get Model through ModelDatabase and queue it with this entity's texture
+    queue.submit(pass, shader, TextureDatabase::getTextureByBlockId(this->blockId).get(),
+                 *ModelDatabase::getModel(this->modelIndex), &this->transform.getModelMatrix(),
+                 glm::distance(center, viewPos));
 }
 
 Skybox::Skybox(const std::string &str, BlockID id) {
     this->blockId = id;
     this->modelName = str;
-    this->tex = TextureDatabase::getTextureByBlockId(id);
-    this->model = ModelDatabase::getModelByName(str);
+    this->modelIndex = ModelDatabase::getModelIndex(str);
 }
 
-void Skybox::draw(Shader &shader) {
-    glDepthFunc(GL_LEQUAL);
-    this->tex->bindTexture();
-    shader.setInt("skybox", 1);
-    // Get Model and draw
-    this->model->draw();
-    glDepthFunc(GL_LESS);
+void Skybox::submit(RenderQueue &queue, Shader &shader) {
+    // The skybox is always behind everything else
+    queue.submit(SKY_PASS, shader, TextureDatabase::getTextureByBlockId(this->blockId).get(),
+                 *ModelDatabase::getModel(this->modelIndex), nullptr, EngineConstants::FAR_PLANE);
 }
 
 
 Sun::Sun(const std::string &str, BlockID id) : Entity(str, id) {}
 
-void Sun::draw(Shader &shader) {
-
-    shader.setMat4("model", this->transform.getModelMatrix());
-
-    this->model->draw();
-}
-
 void Sun::update(float dt) {
 
     glm::quat rotatioQuat = glm::quat(glm::vec3(0.0f, 0.0f, dt / 60.0f));
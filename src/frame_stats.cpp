@@ -0,0 +1,142 @@
+//
+// Created on 10/19/2026.
+//
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include "../libs/easylogging++.h"
+#include "../include/frame_stats.h"
+
+static constexpr size_t BUCKET_COUNT = static_cast<size_t>(FrameHistogram::RANGE_MS / FrameHistogram::BUCKET_WIDTH_MS);
+
+const char *getFrameMetricName(FrameMetric metric) {
+    switch (metric) {
+        case FRAME_TIME:
+            return "frame";
+        case CPU_TIME:
+            return "cpu";
+        case SIMULATION_TIME:
+            return "simulation";
+        case SUBMIT_TIME:
+            return "submit";
+        case SWAP_TIME:
+            return "swap";
+        default:
+            return "unknown";
+    }
+}
+
+FrameHistogram::FrameHistogram() {
+    buckets.resize(BUCKET_COUNT);
+}
+
+void FrameHistogram::record(double milliseconds) {
+    auto bucket = static_cast<size_t>(std::max(0.0, milliseconds) / BUCKET_WIDTH_MS);
+    buckets[std::min(bucket, BUCKET_COUNT - 1)]++;
+    count++;
+    sum += milliseconds;
+    max = std::max(max, milliseconds);
+}
+
+void FrameHistogram::reset() {
+    std::fill(buckets.begin(), buckets.end(), 0);
+    count = 0;
+    sum = 0.0;
+    max = 0.0;
+}
+
+double FrameHistogram::percentile(double fraction) const {
+    if (count == 0)
+        return 0.0;
+
+    auto rank = static_cast<uint64_t>(std::ceil(fraction * static_cast<double>(count)));
+    uint64_t seen = 0;
+    for (size_t i = 0; i < buckets.size(); i++) {
+        seen += buckets[i];
+        if (seen >= rank && seen > 0) {
+            // the upper edge of the bucket, but never more than what was actually recorded
+            return std::min(static_cast<double>(i + 1) * BUCKET_WIDTH_MS, max);
+        }
+    }
+    return max;
+}
+
+FrameStats::FrameStats() {
+    this->intervalStart = now();
+    this->runStart = intervalStart;
+}
+
+void FrameStats::record(FrameMetric metric, double milliseconds) {
+    interval[metric].record(milliseconds);
+    total[metric].record(milliseconds);
+
+    if (metric == FRAME_TIME && milliseconds > HITCH_THRESHOLD_MS) {
+        intervalHitches++;
+        totalHitches++;
+    }
+}
+
+void FrameStats::endFrame() {
+    if (std::chrono::duration<double>(now() - intervalStart).count() >= REPORT_INTERVAL_SECONDS)
+        logInterval();
+}
+
+void FrameStats::logInterval() {
+
+    const FrameHistogram &frames = interval[FRAME_TIME];
+    if (frames.getCount() > 0) {
+        LOG(INFO) << std::fixed << std::setprecision(2) << frames.getCount() << " frames, "
+                  << 1000.0 / frames.mean() << " fps, frame ms mean " << frames.mean()
+                  << " p50 " << frames.percentile(0.5) << " p95 " << frames.percentile(0.95)
+                  << " p99 " << frames.percentile(0.99) << " max " << frames.getMax()
+                  << " | cpu p95 " << interval[CPU_TIME].percentile(0.95)
+                  << " sim p95 " << interval[SIMULATION_TIME].percentile(0.95)
+                  << " submit p95 " << interval[SUBMIT_TIME].percentile(0.95)
+                  << " swap p95 " << interval[SWAP_TIME].percentile(0.95)
+                  << " | " << intervalHitches << " hitches";
+    }
+
+    for (auto &histogram : interval)
+        histogram.reset();
+    intervalHitches = 0;
+    intervalStart = now();
+}
+
+void FrameStats::writeMetrics(std::ostream &out, const std::string &indent) const {
+    out << "{";
+    for (unsigned int metric = 0; metric < FRAME_METRIC_COUNT; metric++) {
+        const FrameHistogram &histogram = total[metric];
+        out << (metric == 0 ? "\n" : ",\n");
+        out << indent << "  \"" << getFrameMetricName(static_cast<FrameMetric>(metric)) << "\": {"
+            << "\"count\": " << histogram.getCount()
+            << ", \"meanMs\": " << histogram.mean()
+            << ", \"p50Ms\": " << histogram.percentile(0.5)
+            << ", \"p95Ms\": " << histogram.percentile(0.95)
+            << ", \"p99Ms\": " << histogram.percentile(0.99)
+            << ", \"maxMs\": " << histogram.getMax() << "}";
+    }
+    out << "\n" << indent << "}";
+}
+
+bool FrameStats::writeReport(const std::string &path) const {
+
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        LOG(WARNING) << "Could not open " << path << " to write the frame statistics.";
+        return false;
+    }
+
+    file << std::fixed << std::setprecision(4);
+    file << "{\n";
+    file << "  \"build\": \"" << __DATE__ << " " << __TIME__ << "\",\n";
+    file << "  \"durationSeconds\": " << std::chrono::duration<double>(now() - runStart).count() << ",\n";
+    file << "  \"hitchThresholdMs\": " << HITCH_THRESHOLD_MS << ",\n";
+    file << "  \"hitches\": " << totalHitches << ",\n";
+    file << "  \"metrics\": ";
+    writeMetrics(file, "  ");
+    file << "\n}\n";
+
+    LOG(INFO) << "Wrote frame statistics to " << path << ".";
+    return true;
+}
@@ -3,6 +3,7 @@
 // inspired by https://github.com/Hopson97/MineCraft-One-Week-Challenge/blob/master/Source/Maths/Frustum.h
 
 #include "../include/frustum.h"
+#include "../include/render_stats.h"
 
 enum Planes {
     FRONT,
@@ -14,6 +15,7 @@ enum Planes {
 };
 
 bool ViewFrustum::isBoxInFrustum(glm::vec3 position, BoundingBox box) const {
+    RenderStats::count(FRUSTUM_TESTS);
 
     for (auto &plane : planes) {
 
@@ -34,6 +36,7 @@ bool ViewFrustum::isBoxInFrustum(glm::vec3 position, BoundingBox box) const {
             vn.z += box.dimensions.z;
 
         if (plane.distanceToPoint(vp) < 0) {
+            RenderStats::count(FRUSTUM_CULLED);
             return false;
         } else if (plane.distanceToPoint(vn) < 0) {
             return true;
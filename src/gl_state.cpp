@@ -0,0 +1,170 @@
+//
+// Created on 10/19/2026.
+//
+#include "../include/gl_state.h"
+
+GLStateCache GLStateCache::instance;
+
+/// Maps a texture target to its slot in the shadowed texture table
+static int textureTargetIndex(GLenum target) {
+    switch (target) {
+        case GL_TEXTURE_2D:
+            return 0;
+        case GL_TEXTURE_CUBE_MAP:
+            return 1;
+        default:
+            return -1;
+    }
+}
+
+/// Maps a capability to its slot in the shadowed capability table
+static int capabilityIndex(GLenum capability) {
+    switch (capability) {
+        case GL_DEPTH_TEST:
+            return 0;
+        case GL_CULL_FACE:
+            return 1;
+        case GL_BLEND:
+            return 2;
+        default:
+            return -1;
+    }
+}
+
+GLStateCache::GLStateCache() {
+    for (auto &unit : textures)
+        unit.fill(UNKNOWN);
+    capabilities.fill(UNKNOWN);
+}
+
+void GLStateCache::setActiveTexture(GLenum unit) {
+    if (activeTexture == unit) {
+        count(ACTIVE_TEXTURE, false);
+        return;
+    }
+    glActiveTexture(unit);
+    activeTexture = unit;
+    count(ACTIVE_TEXTURE, true);
+}
+
+void GLStateCache::useProgram(GLuint programId) {
+    if (instance.program == programId) {
+        instance.count(PROGRAM_BIND, false);
+        return;
+    }
+    glUseProgram(programId);
+    instance.program = programId;
+    instance.count(PROGRAM_BIND, true);
+}
+
+void GLStateCache::bindVertexArray(GLuint vaoId) {
+    if (instance.vertexArray == vaoId) {
+        instance.count(VERTEX_ARRAY_BIND, false);
+        return;
+    }
+    glBindVertexArray(vaoId);
+    instance.vertexArray = vaoId;
+    instance.count(VERTEX_ARRAY_BIND, true);
+}
+
+void GLStateCache::bindTexture(GLenum unit, GLenum target, GLuint textureId) {
+    unsigned int unitIndex = unit - GL_TEXTURE0;
+    int targetIndex = textureTargetIndex(target);
+
+    // untracked unit or target, always let it through
+    if (unitIndex >= MAX_TEXTURE_UNITS || targetIndex < 0) {
+        glActiveTexture(unit);
+        glBindTexture(target, textureId);
+        instance.activeTexture = unit;
+        instance.count(ACTIVE_TEXTURE, true);
+        instance.count(TEXTURE_BIND, true);
+        return;
+    }
+
+    GLuint &bound = instance.textures[unitIndex][targetIndex];
+    if (bound == textureId) {
+        // the active unit is left alone as well, nothing needs to change
+        instance.count(TEXTURE_BIND, false);
+        return;
+    }
+    instance.setActiveTexture(unit);
+    glBindTexture(target, textureId);
+    bound = textureId;
+    instance.count(TEXTURE_BIND, true);
+}
+
+void GLStateCache::depthFunc(GLenum func) {
+    if (instance.depthFunction == func) {
+        instance.count(DEPTH_FUNC, false);
+        return;
+    }
+    glDepthFunc(func);
+    instance.depthFunction = func;
+    instance.count(DEPTH_FUNC, true);
+}
+
+void GLStateCache::depthMask(bool enabled) {
+    GLuint value = enabled ? GL_TRUE : GL_FALSE;
+    if (instance.depthWrite == value) {
+        instance.count(DEPTH_MASK, false);
+        return;
+    }
+    glDepthMask(enabled ? GL_TRUE : GL_FALSE);
+    instance.depthWrite = value;
+    instance.count(DEPTH_MASK, true);
+}
+
+void GLStateCache::setCapability(GLenum capability, bool enabled) {
+    int index = capabilityIndex(capability);
+    GLuint value = enabled ? GL_TRUE : GL_FALSE;
+
+    if (index >= 0 && instance.capabilities[index] == value) {
+        instance.count(CAPABILITY, false);
+        return;
+    }
+    if (enabled)
+        glEnable(capability);
+    else
+        glDisable(capability);
+    if (index >= 0)
+        instance.capabilities[index] = value;
+    instance.count(CAPABILITY, true);
+}
+
+void GLStateCache::forgetTexture(GLuint textureId) {
+    for (auto &unit : instance.textures) {
+        for (GLuint &bound : unit) {
+            if (bound == textureId)
+                bound = 0;
+        }
+    }
+}
+
+void GLStateCache::forgetVertexArray(GLuint vaoId) {
+    if (instance.vertexArray == vaoId)
+        instance.vertexArray = 0;
+}
+
+void GLStateCache::invalidate() {
+    instance.program = UNKNOWN;
+    instance.vertexArray = UNKNOWN;
+    instance.activeTexture = UNKNOWN;
+    for (auto &unit : instance.textures)
+        unit.fill(UNKNOWN);
+    instance.depthFunction = UNKNOWN;
+    instance.depthWrite = UNKNOWN;
+    instance.capabilities.fill(UNKNOWN);
+}
+
+void GLStateCache::beginFrame() {
+    instance.lastFrame = instance.currentFrame;
+    instance.currentFrame = GLStateCounters{};
+}
+
+const GLStateCounters &GLStateCache::getFrameCounters() {
+    return instance.lastFrame;
+}
+
+const GLStateCounters &GLStateCache::getCurrentCounters() {
+    return instance.currentFrame;
+}
@@ -0,0 +1,178 @@
+//
+// Created on 10/19/2026.
+//
+#include <algorithm>
+#include <fstream>
+#include <limits>
+#include "../libs/easylogging++.h"
+#include "../include/input.h"
+
+static constexpr char RECORDING_MAGIC[4] = {'R', 'I', 'N', 'P'};
+static constexpr uint32_t RECORDING_VERSION = 1;
+
+/// Keys that select a block type, in the order of SELECT_BLOCK_1's bits
+static constexpr int BLOCK_KEYS[9] = {GLFW_KEY_1, GLFW_KEY_2, GLFW_KEY_3, GLFW_KEY_4, GLFW_KEY_5, GLFW_KEY_6,
+                                      GLFW_KEY_7, GLFW_KEY_8, GLFW_KEY_9};
+
+// recordings are written in the machine's byte order, they're meant to be replayed on the same kind of machine
+template<typename T>
+static void writeValue(std::ostream &out, const T &value) {
+    out.write(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+template<typename T>
+static bool readValue(std::istream &in, T &value) {
+    return static_cast<bool>(in.read(reinterpret_cast<char *>(&value), sizeof(T)));
+}
+
+uint32_t Input::pollActions(GLFWwindow *window) {
+    uint32_t actions = 0;
+    if (glfwGetKey(window, GLFW_KEY_W) == GLFW_PRESS)
+        actions |= MOVE_FORWARD;
+    if (glfwGetKey(window, GLFW_KEY_S) == GLFW_PRESS)
+        actions |= MOVE_BACKWARD;
+    if (glfwGetKey(window, GLFW_KEY_A) == GLFW_PRESS)
+        actions |= MOVE_LEFT;
+    if (glfwGetKey(window, GLFW_KEY_D) == GLFW_PRESS)
+        actions |= MOVE_RIGHT;
+    if (glfwGetKey(window, GLFW_KEY_SPACE) == GLFW_PRESS)
+        actions |= JUMP;
+    if (glfwGetKey(window, GLFW_KEY_0) == GLFW_PRESS)
+        actions |= TOGGLE_PERSPECTIVE;
+    if (glfwGetKey(window, GLFW_KEY_E) == GLFW_PRESS)
+        actions |= ROTATE_VIEW;
+    if (glfwGetMouseButton(window, GLFW_MOUSE_BUTTON_LEFT) == GLFW_PRESS)
+        actions |= BREAK_BLOCK;
+    if (glfwGetMouseButton(window, GLFW_MOUSE_BUTTON_RIGHT) == GLFW_PRESS)
+        actions |= PLACE_BLOCK;
+    for (unsigned int i = 0; i < 9; i++) {
+        if (glfwGetKey(window, BLOCK_KEYS[i]) == GLFW_PRESS)
+            actions |= SELECT_BLOCK_1 << i;
+    }
+    return actions;
+}
+
+void Input::addCursorPosition(double x, double y) {
+    // the first position only sets the origin, so the view doesn't jump when the cursor is first captured
+    if (hasCursorPosition) {
+        pendingDeltaX += static_cast<float>(x - cursorX);
+        pendingDeltaY += static_cast<float>(y - cursorY);
+    }
+    cursorX = x;
+    cursorY = y;
+    hasCursorPosition = true;
+}
+
+void Input::beginTick(GLFWwindow *window) {
+    previous = current;
+
+    if (replaying) {
+        current = replayTick < ticks.size() ? ticks[replayTick] : InputFrame();
+        replayTick++;
+        return;
+    }
+
+    current = {pollActions(window), pendingDeltaX, pendingDeltaY};
+    pendingDeltaX = 0.0f;
+    pendingDeltaY = 0.0f;
+
+    if (recording)
+        ticks.push_back(current);
+}
+
+void Input::startRecording(const std::string &path) {
+    LOG(INFO) << "Recording the input to " << path << ".";
+    this->recordingPath = path;
+    this->recording = true;
+    this->ticks.clear();
+}
+
+bool Input::finishRecording(RecordingHeader header) {
+    if (!recording)
+        return false;
+    recording = false;
+
+    std::ofstream file(recordingPath, std::ios::binary);
+    if (!file.is_open()) {
+        LOG(WARNING) << "Could not open " << recordingPath << " to write the input recording.";
+        return false;
+    }
+
+    // identical consecutive ticks are stored once, with the number of times they repeat
+    std::vector<std::pair<uint16_t, InputFrame>> runs;
+    for (const InputFrame &tick : ticks) {
+        if (!runs.empty() && runs.back().second == tick && runs.back().first < std::numeric_limits<uint16_t>::max())
+            runs.back().first++;
+        else
+            runs.emplace_back(1, tick);
+    }
+
+    header.tickCount = static_cast<uint32_t>(ticks.size());
+    file.write(RECORDING_MAGIC, sizeof(RECORDING_MAGIC));
+    writeValue(file, RECORDING_VERSION);
+    writeValue(file, header.seed);
+    writeValue(file, header.worldSize);
+    writeValue(file, header.tickCount);
+    writeValue(file, header.worldHash);
+    writeValue(file, static_cast<uint32_t>(runs.size()));
+    for (const auto &run : runs) {
+        writeValue(file, run.first);
+        writeValue(file, run.second.actions);
+        writeValue(file, run.second.mouseDeltaX);
+        writeValue(file, run.second.mouseDeltaY);
+    }
+
+    LOG(INFO) << "Wrote " << header.tickCount << " ticks (" << runs.size() << " runs) of input to " << recordingPath
+              << ".";
+    return static_cast<bool>(file);
+}
+
+bool Input::startReplay(const std::string &path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        LOG(ERROR) << "Could not open the input recording " << path << ".";
+        return false;
+    }
+
+    char magic[sizeof(RECORDING_MAGIC)];
+    uint32_t version = 0;
+    uint32_t runCount = 0;
+    file.read(magic, sizeof(magic));
+    if (!file || !std::equal(magic, magic + sizeof(magic), RECORDING_MAGIC) || !readValue(file, version) ||
+        version != RECORDING_VERSION) {
+        LOG(ERROR) << path << " is not an input recording, or was made by another version.";
+        return false;
+    }
+
+    RecordingHeader header;
+    if (!readValue(file, header.seed) || !readValue(file, header.worldSize) || !readValue(file, header.tickCount) ||
+        !readValue(file, header.worldHash) || !readValue(file, runCount)) {
+        LOG(ERROR) << "The input recording " << path << " is truncated.";
+        return false;
+    }
+
+    ticks.clear();
+    ticks.reserve(header.tickCount);
+    for (uint32_t i = 0; i < runCount; i++) {
+        uint16_t length = 0;
+        InputFrame tick;
+        if (!readValue(file, length) || !readValue(file, tick.actions) || !readValue(file, tick.mouseDeltaX) ||
+            !readValue(file, tick.mouseDeltaY)) {
+            LOG(ERROR) << "The input recording " << path << " is truncated.";
+            return false;
+        }
+        ticks.insert(ticks.end(), length, tick);
+    }
+
+    if (ticks.size() != header.tickCount) {
+        LOG(ERROR) << "The input recording " << path << " holds " << ticks.size() << " ticks instead of "
+                   << header.tickCount << ".";
+        return false;
+    }
+
+    LOG(INFO) << "Replaying " << header.tickCount << " ticks of input from " << path << ".";
+    this->replayHeader = header;
+    this->replayTick = 0;
+    this->replaying = true;
+    return true;
+}
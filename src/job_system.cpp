@@ -0,0 +1,244 @@
+//
+// Created on 10/19/2026.
+//
+#include <algorithm>
+#include <exception>
+#include "../libs/easylogging++.h"
+#include "../include/job_system.h"
+#include "../include/profiler.h"
+
+/// Index of the worker running on the current thread, -1 on any other thread
+static thread_local int currentWorkerIndex = -1;
+
+/// A unit of work, shared between its handles and the jobs that depend on it
+struct Job {
+    std::function<void()> work;
+    JobAffinity affinity = ANY_THREAD;
+    std::atomic<unsigned int> pendingDependencies{0};
+    std::atomic<bool> done{false};
+    std::mutex mutex; // guards the continuations and the done transition
+    std::vector<std::shared_ptr<Job>> continuations{};
+};
+
+bool JobHandle::isDone() const {
+    return !job || job->done.load(std::memory_order_acquire);
+}
+
+JobSystem::JobSystem(unsigned int workerCount) {
+    this->mainThreadId = std::this_thread::get_id();
+
+    if (workerCount == 0) {
+        unsigned int hardwareThreads = std::thread::hardware_concurrency();
+        workerCount = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+    }
+
+    for (unsigned int i = 0; i < workerCount; i++) {
+        workers.push_back(std::make_unique<Worker>());
+    }
+    for (unsigned int i = 0; i < workerCount; i++) {
+        threads.emplace_back(&JobSystem::workerLoop, this, i);
+    }
+    LOG(INFO) << "Started job system with " << workerCount << " worker threads.";
+}
+
+JobSystem::~JobSystem() {
+    // let the workers drain their deques first, so that nobody waits on a job that will never run
+    while (queuedJobs.load() > 0) {
+        std::this_thread::yield();
+    }
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping = true;
+    }
+    wakeUp.notify_all();
+    for (auto &thread : threads) {
+        thread.join();
+    }
+}
+
+JobHandle JobSystem::submit(std::function<void()> work, const std::vector<JobHandle> &dependencies,
+                            JobAffinity affinity) {
+
+    auto job = std::make_shared<Job>();
+    job->work = std::move(work);
+    job->affinity = affinity;
+
+    // the extra count keeps the job from being scheduled while its dependencies are still being registered
+    job->pendingDependencies = static_cast<unsigned int>(dependencies.size()) + 1;
+    for (const auto &dependency : dependencies) {
+        bool alreadyDone = true;
+        if (dependency.job) {
+            std::lock_guard<std::mutex> lock(dependency.job->mutex);
+            if (!dependency.job->done.load(std::memory_order_acquire)) {
+                dependency.job->continuations.push_back(job);
+                alreadyDone = false;
+            }
+        }
+        if (alreadyDone)
+            job->pendingDependencies--;
+    }
+
+    if (--job->pendingDependencies == 0)
+        schedule(job);
+    return JobHandle(job);
+}
+
+JobHandle JobSystem::parallelFor(unsigned int begin, unsigned int end, unsigned int grainSize,
+                                 const std::function<void(unsigned int, unsigned int)> &work) {
+    if (grainSize == 0)
+        grainSize = 1;
+
+    std::vector<JobHandle> ranges;
+    ranges.reserve((end - begin) / grainSize + 1);
+    for (unsigned int first = begin; first < end; first += grainSize) {
+        unsigned int last = std::min(end, first + grainSize);
+        ranges.push_back(submit([work, first, last]() { work(first, last); }));
+    }
+    return submit([]() {}, ranges);
+}
+
+void JobSystem::schedule(const std::shared_ptr<Job> &job) {
+
+    if (job->affinity == MAIN_THREAD) {
+        std::lock_guard<std::mutex> lock(mainThreadMutex);
+        mainThreadJobs.push_back(job);
+        return;
+    }
+
+    // jobs spawned by a worker stay on it, others are spread round robin
+    unsigned int target = currentWorkerIndex >= 0 ? static_cast<unsigned int>(currentWorkerIndex)
+                                                  : nextWorker++ % static_cast<unsigned int>(workers.size());
+    {
+        // counted first so that the count never drops below the number of queued jobs, and under the sleep mutex so
+        // that a worker can't miss the wake up between checking the count and going to sleep
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        queuedJobs++;
+    }
+    {
+        std::lock_guard<std::mutex> lock(workers[target]->mutex);
+        workers[target]->jobs.push_back(job);
+    }
+    wakeUp.notify_one();
+}
+
+std::shared_ptr<Job> JobSystem::findJob(int workerIndex) {
+
+    if (workerIndex >= 0) {
+        Worker &own = *workers[workerIndex];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.jobs.empty()) {
+            std::shared_ptr<Job> job = std::move(own.jobs.back());
+            own.jobs.pop_back();
+            queuedJobs--;
+            return job;
+        }
+    }
+
+    // steal the oldest job of another worker, starting after ourselves so that thieves spread out
+    auto workerCount = static_cast<unsigned int>(workers.size());
+    unsigned int start = workerIndex >= 0 ? static_cast<unsigned int>(workerIndex) + 1 : 0;
+    for (unsigned int i = 0; i < workerCount; i++) {
+        Worker &victim = *workers[(start + i) % workerCount];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.jobs.empty()) {
+            std::shared_ptr<Job> job = std::move(victim.jobs.front());
+            victim.jobs.pop_front();
+            queuedJobs--;
+            stolenCount++;
+            return job;
+        }
+    }
+    return nullptr;
+}
+
+void JobSystem::execute(const std::shared_ptr<Job> &job) {
+
+    try {
+        PROFILE_SCOPE("Job");
+        job->work();
+    } catch (const std::exception &e) {
+        LOG(ERROR) << "Job threw an exception: " << e.what();
+    }
+    job->work = nullptr; // release captured state now rather than when the last handle goes away
+
+    std::vector<std::shared_ptr<Job>> continuations;
+    {
+        std::lock_guard<std::mutex> lock(job->mutex);
+        job->done.store(true, std::memory_order_release);
+        continuations.swap(job->continuations);
+    }
+    executedCount++;
+
+    for (const auto &continuation : continuations) {
+        if (--continuation->pendingDependencies == 0)
+            schedule(continuation);
+    }
+}
+
+void JobSystem::workerLoop(unsigned int workerIndex) {
+
+    currentWorkerIndex = static_cast<int>(workerIndex);
+    PROFILE_THREAD_NAME("Worker " + std::to_string(workerIndex));
+
+    while (true) {
+        std::shared_ptr<Job> job = findJob(currentWorkerIndex);
+        if (job) {
+            execute(job);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        wakeUp.wait(lock, [this]() { return stopping.load() || queuedJobs.load() > 0; });
+        if (stopping.load() && queuedJobs.load() == 0)
+            return;
+    }
+}
+
+void JobSystem::wait(const JobHandle &job) {
+
+    bool onMainThread = std::this_thread::get_id() == mainThreadId;
+    while (!job.isDone()) {
+        if (onMainThread && runMainThreadJobs(1) > 0)
+            continue;
+
+        std::shared_ptr<Job> other = findJob(currentWorkerIndex);
+        if (other) {
+            execute(other);
+        } else {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void JobSystem::waitAll(const std::vector<JobHandle> &jobs) {
+    for (const auto &job : jobs) {
+        wait(job);
+    }
+}
+
+unsigned int JobSystem::runMainThreadJobs(unsigned int maxJobs) {
+
+    unsigned int count = 0;
+    while (count < maxJobs) {
+        std::shared_ptr<Job> job;
+        {
+            std::lock_guard<std::mutex> lock(mainThreadMutex);
+            if (mainThreadJobs.empty())
+                break;
+            job = std::move(mainThreadJobs.front());
+            mainThreadJobs.pop_front();
+        }
+        execute(job);
+        mainThreadCount++;
+        count++;
+    }
+    return count;
+}
+
+JobSystemStats JobSystem::getStats() const {
+    JobSystemStats stats;
+    stats.executed = executedCount.load();
+    stats.stolen = stolenCount.load();
+    stats.mainThreadExecuted = mainThreadCount.load();
+    return stats;
+}
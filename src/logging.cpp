@@ -0,0 +1,174 @@
+//
+// Created on 10/19/2026.
+//
+#include <iostream>
+#include "../include/logging.h"
+
+AsyncLogSink AsyncLogSink::instance;
+
+static const char *DEFAULT_DISPATCH_ID = "DefaultLogDispatchCallback";
+static const char *RING_DISPATCH_ID = "RingLogDispatchCallback";
+
+int64_t LogRateLimiter::nowMs() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+bool LogRateLimiter::allow() {
+    int64_t now = nowMs();
+    int64_t last = lastAllowedMs.load(std::memory_order_relaxed);
+    // only one of the threads that reach the end of the interval at the same time gets to log
+    if (now - last < intervalMs || !lastAllowedMs.compare_exchange_strong(last, now, std::memory_order_relaxed)) {
+        suppressed.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    suppressedBeforeAllowed.store(suppressed.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+    return true;
+}
+
+std::string LogRateLimiter::takeSuppressedNote() {
+    uint64_t count = suppressedBeforeAllowed.exchange(0, std::memory_order_relaxed);
+    if (count == 0)
+        return {};
+    return "(" + std::to_string(count) + " similar messages suppressed) ";
+}
+
+/// Formats the messages on the thread that logs them and hands them to the AsyncLogSink
+class RingLogDispatchCallback : public el::LogDispatchCallback {
+protected:
+    void handle(const el::LogDispatchData *data) override {
+        if (data->dispatchAction() != el::base::DispatchAction::NormalLog)
+            return;
+
+        const el::LogMessage *message = data->logMessage();
+        el::Logger *logger = message->logger();
+        el::base::TypedConfigurations *configurations = logger->typedConfigurations();
+        el::Level level = message->level();
+
+        AsyncLogSink::Entry entry;
+        entry.line = logger->logBuilder()->build(message, true);
+        if (configurations->toFile(level))
+            entry.filename = configurations->filename(level);
+        if (configurations->toStandardOutput(level)) {
+            entry.consoleLine = entry.line;
+            if (el::Loggers::hasFlag(el::LoggingFlag::ColoredTerminalOutput))
+                logger->logBuilder()->convertToColoredOutput(&entry.consoleLine, level);
+        }
+
+        if (level == el::Level::Fatal)
+            AsyncLogSink::instance.write({std::move(entry)});
+        else
+            AsyncLogSink::instance.push(std::move(entry));
+    }
+};
+
+void AsyncLogSink::start(size_t capacity) {
+    {
+        std::lock_guard<std::mutex> lock(instance.mutex);
+        if (instance.running)
+            return;
+        instance.ring.assign(capacity, Entry());
+        instance.head = 0;
+        instance.size = 0;
+        instance.running = true;
+    }
+    instance.writer = std::thread(&AsyncLogSink::writerLoop, &instance);
+
+    el::Helpers::installLogDispatchCallback<RingLogDispatchCallback>(RING_DISPATCH_ID);
+    el::Helpers::uninstallLogDispatchCallback<el::base::DefaultLogDispatchCallback>(DEFAULT_DISPATCH_ID);
+}
+
+void AsyncLogSink::stop() {
+    if (!instance.writer.joinable())
+        return;
+    el::Helpers::installLogDispatchCallback<el::base::DefaultLogDispatchCallback>(DEFAULT_DISPATCH_ID);
+    el::Helpers::uninstallLogDispatchCallback<RingLogDispatchCallback>(RING_DISPATCH_ID);
+
+    // the writer empties the ring before it returns
+    {
+        std::lock_guard<std::mutex> lock(instance.mutex);
+        instance.running = false;
+    }
+    instance.wakeWriter.notify_one();
+    instance.writer.join();
+
+    std::lock_guard<std::mutex> lock(instance.outputMutex);
+    instance.files.clear();
+}
+
+AsyncLogSink::~AsyncLogSink() {
+    if (!writer.joinable())
+        return;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        running = false;
+    }
+    wakeWriter.notify_one();
+    writer.join();
+}
+
+uint64_t AsyncLogSink::getDroppedCount() {
+    std::lock_guard<std::mutex> lock(instance.mutex);
+    return instance.dropped;
+}
+
+void AsyncLogSink::push(Entry &&entry) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (size == ring.size()) {
+            dropped++;
+            return;
+        }
+        ring[(head + size) % ring.size()] = std::move(entry);
+        size++;
+    }
+    wakeWriter.notify_one();
+}
+
+void AsyncLogSink::write(const std::vector<Entry> &entries) {
+    std::lock_guard<std::mutex> lock(outputMutex);
+    for (const Entry &entry : entries) {
+        if (!entry.filename.empty()) {
+            auto file = files.find(entry.filename);
+            if (file == files.end())
+                file = files.emplace(entry.filename, std::ofstream(entry.filename, std::ios::app)).first;
+            file->second << entry.line;
+        }
+        if (!entry.consoleLine.empty())
+            std::cout << entry.consoleLine;
+    }
+    for (auto &file : files)
+        file.second.flush();
+    std::cout.flush();
+}
+
+void AsyncLogSink::writerLoop() {
+    std::vector<Entry> batch;
+    while (true) {
+        uint64_t newlyDropped;
+        bool stopping;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wakeWriter.wait(lock, [this] { return size > 0 || !running; });
+            batch.clear();
+            for (; size > 0; size--) {
+                batch.push_back(std::move(ring[head]));
+                head = (head + 1) % ring.size();
+            }
+            newlyDropped = dropped - droppedReported;
+            droppedReported = dropped;
+            stopping = !running;
+        }
+
+        if (newlyDropped > 0) {
+            Entry note;
+            note.line = "Log ring full, dropped " + std::to_string(newlyDropped) + " messages.\n";
+            note.consoleLine = note.line;
+            batch.push_back(std::move(note));
+        }
+        write(batch);
+
+        if (stopping)
+            return;
+    }
+}
@@ -0,0 +1,122 @@
+//
+// Created on 10/19/2026.
+//
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include "../libs/easylogging++.h"
+#include "../include/memory_stats.h"
+
+MemoryStats MemoryStats::instance;
+
+const char *getMemoryCategoryName(MemoryCategory category) {
+    switch (category) {
+        case WORLD_ENTITIES:
+            return "worldEntities";
+        case WORLD_INDICES:
+            return "worldIndices";
+        case CHUNK_MESHES_CPU:
+            return "chunkMeshesCpu";
+        case CHUNK_MESHES_GPU:
+            return "chunkMeshesGpu";
+        case MODEL_VERTICES:
+            return "modelVertices";
+        case TEXTURE_STAGING:
+            return "textureStaging";
+        case TEXTURES_GPU:
+            return "texturesGpu";
+        case SOUNDS:
+            return "sounds";
+        default:
+            return "unknown";
+    }
+}
+
+void MemoryStats::updatePeak(Counter &counter, int64_t bytes) {
+    int64_t peak = counter.peakBytes.load(std::memory_order_relaxed);
+    while (bytes > peak && !counter.peakBytes.compare_exchange_weak(peak, bytes, std::memory_order_relaxed));
+}
+
+void MemoryStats::add(MemoryCategory category, int64_t bytes, int64_t objects) {
+    Counter &counter = instance.counters[category];
+    int64_t total = counter.bytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+    counter.objects.fetch_add(objects, std::memory_order_relaxed);
+    updatePeak(counter, total);
+}
+
+void MemoryStats::remove(MemoryCategory category, int64_t bytes, int64_t objects) {
+    Counter &counter = instance.counters[category];
+    counter.bytes.fetch_sub(bytes, std::memory_order_relaxed);
+    counter.objects.fetch_sub(objects, std::memory_order_relaxed);
+}
+
+void MemoryStats::set(MemoryCategory category, int64_t bytes, int64_t objects) {
+    Counter &counter = instance.counters[category];
+    counter.bytes.store(bytes, std::memory_order_relaxed);
+    counter.objects.store(objects, std::memory_order_relaxed);
+    updatePeak(counter, bytes);
+}
+
+int64_t MemoryStats::getBytes(MemoryCategory category) {
+    return instance.counters[category].bytes.load(std::memory_order_relaxed);
+}
+
+int64_t MemoryStats::getPeakBytes(MemoryCategory category) {
+    return instance.counters[category].peakBytes.load(std::memory_order_relaxed);
+}
+
+int64_t MemoryStats::getObjects(MemoryCategory category) {
+    return instance.counters[category].objects.load(std::memory_order_relaxed);
+}
+
+/// Formats a size in bytes as KiB or MiB
+static std::string formatBytes(int64_t bytes) {
+    std::ostringstream stream;
+    stream << std::fixed << std::setprecision(1);
+    if (bytes >= 1024 * 1024)
+        stream << static_cast<double>(bytes) / (1024.0 * 1024.0) << " MiB";
+    else
+        stream << static_cast<double>(bytes) / 1024.0 << " KiB";
+    return stream.str();
+}
+
+void MemoryStats::logBreakdown() {
+    int64_t total = 0;
+    LOG(INFO) << "Memory usage:";
+    for (unsigned int i = 0; i < MEMORY_CATEGORY_COUNT; i++) {
+        auto category = static_cast<MemoryCategory>(i);
+        int64_t bytes = getBytes(category);
+        int64_t objects = getObjects(category);
+        total += bytes;
+
+        LOG(INFO) << "  " << getMemoryCategoryName(category) << ": " << formatBytes(bytes) << " (peak "
+                  << formatBytes(getPeakBytes(category)) << ") in " << objects << " objects"
+                  << (objects > 0 ? ", " + std::to_string(bytes / objects) + " bytes each" : "");
+    }
+    LOG(INFO) << "  total: " << formatBytes(total);
+}
+
+bool MemoryStats::writeReport(const std::string &path) {
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        LOG(WARNING) << "Could not open " << path << " to write the memory report.";
+        return false;
+    }
+
+    int64_t total = 0;
+    file << "{\n";
+    file << "  \"categories\": {";
+    for (unsigned int i = 0; i < MEMORY_CATEGORY_COUNT; i++) {
+        auto category = static_cast<MemoryCategory>(i);
+        total += getBytes(category);
+        file << (i == 0 ? "\n" : ",\n");
+        file << "    \"" << getMemoryCategoryName(category) << "\": {\"bytes\": " << getBytes(category)
+             << ", \"peakBytes\": " << getPeakBytes(category) << ", \"objects\": " << getObjects(category) << "}";
+    }
+    file << "\n  },\n";
+    file << "  \"totalBytes\": " << total << "\n";
+    file << "}\n";
+
+    LOG(INFO) << "Wrote the memory report to " << path << ".";
+    return true;
+}
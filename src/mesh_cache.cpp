@@ -0,0 +1,119 @@
+//
+// Created on 10/19/2026.
+//
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include "../include/mesh_cache.h"
+#include "../include/cache_file.h"
+#include "../include/engine_constants.h"
+
+/// Bumped whenever the layout of the entries or the processing of the meshes changes, so older entries are made again
+static constexpr uint32_t MESH_CACHE_VERSION = 3;
+static constexpr char MESH_CACHE_MAGIC[4] = {'M', 'E', 'S', 'H'};
+
+// the vertices are stored as they are in memory
+static_assert(sizeof(Vertex) == 8 * sizeof(float), "Vertex must be tightly packed to be cached");
+
+/** Start of every cache entry. It is followed by the mesh name (padded to 4 bytes), the vertices, and the indices.
+ * Every section stays 4-byte aligned in the file.
+ */
+struct MeshCacheHeader {
+    char magic[4];
+    uint32_t version;
+    uint64_t sourceSize;   // to tell if the source model changed since the entry was made
+    int64_t sourceTime;
+    uint32_t vertexCount;
+    uint32_t indexCount;
+    uint32_t indexSize;    // 2 or 4 bytes
+    uint32_t nameLength;
+};
+
+/// The name of the mesh is padded so that the vertices after it are aligned
+static size_t paddedNameLength(size_t nameLength) {
+    return (nameLength + 3) / 4 * 4;
+}
+
+/// The entry of a source model (all of them live in resources/models)
+static std::filesystem::path cachePath(const std::string &sourcePath) {
+    return CacheFile::getPath(EngineConstants::MESH_CACHE_DIR, sourcePath, ".mesh");
+}
+
+bool MeshCache::load(const std::string &sourcePath, Mesh &mesh) {
+    MeshCacheHeader source{};
+    if (!CacheFile::describeSource(sourcePath, source))
+        return false;
+
+    std::error_code error;
+    std::filesystem::path path = cachePath(sourcePath);
+    uintmax_t fileSize = std::filesystem::file_size(path, error);
+    std::ifstream file(path, std::ios::binary);
+    if (error || !file.is_open() || fileSize < sizeof(MeshCacheHeader))
+        return false;
+
+    MeshCacheHeader header{};
+    file.read(reinterpret_cast<char *>(&header), sizeof(header));
+    if (!file || std::memcmp(header.magic, MESH_CACHE_MAGIC, sizeof(header.magic)) != 0 ||
+        header.version != MESH_CACHE_VERSION || header.sourceSize != source.sourceSize ||
+        header.sourceTime != source.sourceTime ||
+        (header.indexSize != 2 && header.indexSize != 4))
+        return false;
+
+    size_t nameBytes = paddedNameLength(header.nameLength);
+    size_t vertexBytes = static_cast<size_t>(header.vertexCount) * sizeof(Vertex);
+    size_t indexBytes = static_cast<size_t>(header.indexCount) * header.indexSize;
+    if (sizeof(header) + nameBytes + vertexBytes + indexBytes != fileSize)
+        return false;
+
+    // every section is read in one call straight into the mesh, only 16-bit indices go through a buffer to be widened
+    mesh.meshName.resize(nameBytes);
+    file.read(mesh.meshName.data(), static_cast<std::streamsize>(nameBytes));
+    mesh.meshName.resize(header.nameLength);
+    mesh.vertices.resize(header.vertexCount);
+    file.read(reinterpret_cast<char *>(mesh.vertices.data()), static_cast<std::streamsize>(vertexBytes));
+    if (header.indexSize == 2) {
+        std::vector<uint16_t> indices(header.indexCount);
+        file.read(reinterpret_cast<char *>(indices.data()), static_cast<std::streamsize>(indexBytes));
+        mesh.indices.assign(indices.begin(), indices.end());
+    } else {
+        mesh.indices.resize(header.indexCount);
+        file.read(reinterpret_cast<char *>(mesh.indices.data()), static_cast<std::streamsize>(indexBytes));
+    }
+    if (!file)
+        return false;
+    for (uint32_t index : mesh.indices) {
+        if (index >= header.vertexCount)
+            return false;
+    }
+    return true;
+}
+
+bool MeshCache::store(const std::string &sourcePath, const Mesh &mesh) {
+    MeshCacheHeader header{};
+    if (!CacheFile::describeSource(sourcePath, header))
+        return false;
+    std::memcpy(header.magic, MESH_CACHE_MAGIC, sizeof(header.magic));
+    header.version = MESH_CACHE_VERSION;
+    header.vertexCount = static_cast<uint32_t>(mesh.vertices.size());
+    header.indexCount = static_cast<uint32_t>(mesh.indices.size());
+    header.indexSize = mesh.vertices.size() <= std::numeric_limits<uint16_t>::max() + 1u ? 2 : 4;
+    header.nameLength = static_cast<uint32_t>(mesh.meshName.size());
+
+    return CacheFile::write(cachePath(sourcePath), sourcePath, [&](std::ostream &file) {
+        file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        std::string name = mesh.meshName;
+        name.resize(paddedNameLength(name.size()), '\0');
+        file.write(name.data(), static_cast<std::streamsize>(name.size()));
+        file.write(reinterpret_cast<const char *>(mesh.vertices.data()),
+                   static_cast<std::streamsize>(mesh.vertices.size() * sizeof(Vertex)));
+        if (header.indexSize == 2) {
+            std::vector<uint16_t> indices(mesh.indices.begin(), mesh.indices.end());
+            file.write(reinterpret_cast<const char *>(indices.data()),
+                       static_cast<std::streamsize>(indices.size() * sizeof(uint16_t)));
+        } else {
+            file.write(reinterpret_cast<const char *>(mesh.indices.data()),
+                       static_cast<std::streamsize>(mesh.indices.size() * sizeof(uint32_t)));
+        }
+    });
+}
@@ -0,0 +1,198 @@
+//
+// Created on 10/19/2026.
+//
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <glm/gtc/packing.hpp>
+#include "../include/mesh_optimizer.h"
+
+/// Size of the LRU cache modelled while scoring, bigger than the real one so that the order suits any GPU
+static constexpr int FORSYTH_CACHE_SIZE = 32;
+static constexpr float FORSYTH_CACHE_DECAY_POWER = 1.5f;
+static constexpr float FORSYTH_LAST_TRIANGLE_SCORE = 0.75f;
+static constexpr float FORSYTH_VALENCE_BOOST_SCALE = 2.0f;
+static constexpr float FORSYTH_VALENCE_BOOST_POWER = 0.5f;
+
+/** Scores a vertex: vertices in the cache score higher the more recently they were used, and vertices with few
+ * triangles left get a boost so that they're finished off rather than left behind.
+ *
+ * @param cachePosition the position of the vertex in the modelled cache, -1 if it isn't in it
+ * @param valence the number of triangles using the vertex that still have to be emitted
+ */
+static float forsythScore(int cachePosition, uint32_t valence) {
+    if (valence == 0)
+        return -1.0f;
+
+    float score = 0.0f;
+    if (cachePosition >= 0) {
+        // the three vertices of the last triangle get the same score, so that the next one doesn't favour any of them
+        if (cachePosition < 3) {
+            score = FORSYTH_LAST_TRIANGLE_SCORE;
+        } else {
+            float scale = 1.0f / (FORSYTH_CACHE_SIZE - 3);
+            score = std::pow(1.0f - static_cast<float>(cachePosition - 3) * scale, FORSYTH_CACHE_DECAY_POWER);
+        }
+    }
+    return score + FORSYTH_VALENCE_BOOST_SCALE * std::pow(static_cast<float>(valence), -FORSYTH_VALENCE_BOOST_POWER);
+}
+
+void optimizeVertexCache(std::vector<uint32_t> &indices, size_t vertexCount) {
+    size_t triangleCount = indices.size() / 3;
+    if (triangleCount == 0)
+        return;
+
+    // the triangles still to emit that use each vertex: those of vertex v are the first valence[v] from offsets[v]
+    std::vector<uint32_t> valence(vertexCount, 0);
+    for (uint32_t index : indices)
+        valence[index]++;
+    std::vector<uint32_t> offsets(vertexCount + 1, 0);
+    for (size_t v = 0; v < vertexCount; v++)
+        offsets[v + 1] = offsets[v] + valence[v];
+    std::vector<uint32_t> adjacency(indices.size());
+    std::vector<uint32_t> filled(offsets.begin(), offsets.end() - 1);
+    for (size_t t = 0; t < triangleCount; t++) {
+        for (size_t k = 0; k < 3; k++)
+            adjacency[filled[indices[3 * t + k]]++] = static_cast<uint32_t>(t);
+    }
+
+    std::vector<float> vertexScores(vertexCount);
+    for (size_t v = 0; v < vertexCount; v++)
+        vertexScores[v] = forsythScore(-1, valence[v]);
+    std::vector<float> triangleScores(triangleCount);
+    for (size_t t = 0; t < triangleCount; t++) {
+        triangleScores[t] = vertexScores[indices[3 * t]] + vertexScores[indices[3 * t + 1]] +
+                            vertexScores[indices[3 * t + 2]];
+    }
+
+    std::vector<char> emitted(triangleCount, false);
+    std::vector<uint32_t> cache, evicted;
+    cache.reserve(FORSYTH_CACHE_SIZE + 3);
+    std::vector<uint32_t> output;
+    output.reserve(indices.size());
+    size_t firstRemaining = 0;
+    int64_t best = -1;
+
+    while (output.size() < indices.size()) {
+        if (best < 0) {
+            // nothing left around the cache, start again from the best remaining triangle
+            while (emitted[firstRemaining])
+                firstRemaining++;
+            best = static_cast<int64_t>(firstRemaining);
+            for (size_t t = firstRemaining + 1; t < triangleCount; t++) {
+                if (!emitted[t] && triangleScores[t] > triangleScores[best])
+                    best = static_cast<int64_t>(t);
+            }
+        }
+
+        auto triangle = static_cast<size_t>(best);
+        emitted[triangle] = true;
+        for (size_t k = 0; k < 3; k++) {
+            uint32_t vertex = indices[3 * triangle + k];
+            output.push_back(vertex);
+
+            uint32_t *first = &adjacency[offsets[vertex]];
+            uint32_t *last = first + valence[vertex];
+            std::iter_swap(std::find(first, last, static_cast<uint32_t>(triangle)), last - 1);
+            valence[vertex]--;
+
+            auto cached = std::find(cache.begin(), cache.end(), vertex);
+            if (cached != cache.end())
+                cache.erase(cached);
+            cache.insert(cache.begin(), vertex);
+        }
+
+        evicted.clear();
+        while (cache.size() > FORSYTH_CACHE_SIZE) {
+            evicted.push_back(cache.back());
+            cache.pop_back();
+        }
+        for (size_t i = 0; i < cache.size(); i++)
+            vertexScores[cache[i]] = forsythScore(static_cast<int>(i), valence[cache[i]]);
+        for (uint32_t vertex : evicted)
+            vertexScores[vertex] = forsythScore(-1, valence[vertex]);
+
+        // only the triangles of the cached vertices are candidates for the next one
+        best = -1;
+        float bestScore = -1.0f;
+        auto rescore = [&](uint32_t vertex, bool candidate) {
+            for (uint32_t i = offsets[vertex]; i < offsets[vertex] + valence[vertex]; i++) {
+                uint32_t t = adjacency[i];
+                triangleScores[t] = vertexScores[indices[3 * t]] + vertexScores[indices[3 * t + 1]] +
+                                    vertexScores[indices[3 * t + 2]];
+                if (candidate && triangleScores[t] > bestScore) {
+                    bestScore = triangleScores[t];
+                    best = t;
+                }
+            }
+        };
+        for (uint32_t vertex : cache)
+            rescore(vertex, true);
+        for (uint32_t vertex : evicted)
+            rescore(vertex, false);
+    }
+
+    indices.swap(output);
+}
+
+void optimizeVertexFetch(std::vector<Vertex> &vertices, std::vector<uint32_t> &indices) {
+    std::vector<uint32_t> remap(vertices.size(), std::numeric_limits<uint32_t>::max());
+    std::vector<Vertex> ordered;
+    ordered.reserve(vertices.size());
+    for (uint32_t &index : indices) {
+        if (remap[index] == std::numeric_limits<uint32_t>::max()) {
+            remap[index] = static_cast<uint32_t>(ordered.size());
+            ordered.push_back(vertices[index]);
+        }
+        index = remap[index];
+    }
+    vertices.swap(ordered);
+}
+
+void optimizeMesh(Mesh &mesh) {
+    size_t vertexCount = mesh.vertices.size();
+    std::vector<uint32_t> indices = mesh.indices;
+    optimizeVertexCache(indices, vertexCount);
+    if (averageCacheMissRatio(indices, vertexCount) < averageCacheMissRatio(mesh.indices, vertexCount))
+        mesh.indices.swap(indices);
+    optimizeVertexFetch(mesh.vertices, mesh.indices);
+}
+
+float averageCacheMissRatio(const std::vector<uint32_t> &indices, size_t vertexCount, unsigned int cacheSize) {
+    if (indices.size() < 3)
+        return 0.0f;
+
+    // a vertex is in the FIFO if fewer than cacheSize misses happened since it was inserted
+    std::vector<uint64_t> insertedAt(vertexCount, 0);
+    uint64_t misses = 0;
+    for (uint32_t index : indices) {
+        if (insertedAt[index] == 0 || misses - insertedAt[index] >= cacheSize) {
+            misses++;
+            insertedAt[index] = misses;
+        }
+    }
+    return static_cast<float>(misses) / static_cast<float>(indices.size() / 3);
+}
+
+bool quantizeVertices(const std::vector<Vertex> &vertices, std::vector<QuantizedVertex> &quantized) {
+    for (const Vertex &vertex : vertices) {
+        const glm::vec2 &uv = vertex.textureCoordinate;
+        if (uv.x < 0.0f || uv.x > 1.0f || uv.y < 0.0f || uv.y > 1.0f)
+            return false;
+    }
+
+    quantized.resize(vertices.size());
+    for (size_t i = 0; i < vertices.size(); i++) {
+        const Vertex &vertex = vertices[i];
+        QuantizedVertex &packed = quantized[i];
+        for (int c = 0; c < 3; c++)
+            packed.position[c] = glm::packHalf1x16(vertex.position[c]);
+        packed.padding = 0;
+        float length = glm::length(vertex.normal);
+        glm::vec3 normal = length > 0.0f ? vertex.normal / length : vertex.normal;
+        packed.normal = glm::packSnorm3x10_1x2(glm::vec4(normal, 0.0f));
+        packed.textureCoordinate[0] = glm::packUnorm1x16(vertex.textureCoordinate.x);
+        packed.textureCoordinate[1] = glm::packUnorm1x16(vertex.textureCoordinate.y);
+    }
+    return true;
+}
@@ -1,49 +1,92 @@
 //
 // Created by Willi on 7/30/2020.
 //
+#include <cstddef>
+#include <limits>
 #include "../include/model.h"
+#include "../include/mesh_optimizer.h"
+#include "../include/gl_state.h"
+#include "../include/render_stats.h"
+#include "../include/memory_stats.h"
 
-Model::Model(Mesh &mesh) {
+Model::Model(Mesh &mesh, BufferArena &arena, bool quantize) {
+
+    std::vector<QuantizedVertex> quantizedVertices;
+    bool quantized = quantize && quantizeVertices(mesh.vertices, quantizedVertices);
 
     this->modelName = mesh.meshName + "Model";
-    this->numVertices = mesh.vertices.size();
+    this->numIndices = mesh.indices.size();
+    this->indexType = mesh.vertices.size() <= std::numeric_limits<uint16_t>::max() + 1u ? GL_UNSIGNED_SHORT
+                                                                                         : GL_UNSIGNED_INT;
+    this->vertexStride = quantized ? sizeof(QuantizedVertex) : sizeof(Vertex);
+    this->arena = &arena;
 
-    glGenVertexArrays(1, &vaoID);
-    glGenBuffers(1, &vboID);
-    glGenBuffers(1, &iboId);
+    std::vector<uint16_t> shortIndices;
+    const void *indices = mesh.indices.data();
+    if (indexType == GL_UNSIGNED_SHORT) {
+        shortIndices.assign(mesh.indices.begin(), mesh.indices.end());
+        indices = shortIndices.data();
+    }
 
-    glBindVertexArray(vaoID);
-    glBindBuffer(GL_ARRAY_BUFFER, vboID);
+    // vertices first, then the indices, in one range aligned to the vertex stride so that the base vertex is exact
+    this->vertexBytes = static_cast<GLsizeiptr>(mesh.vertices.size()) * vertexStride;
+    this->indexBytes = static_cast<GLsizeiptr>(mesh.indices.size()) *
+                       (indexType == GL_UNSIGNED_SHORT ? sizeof(uint16_t) : sizeof(uint32_t));
+    this->allocation = arena.allocate(vertexBytes + indexBytes, vertexStride);
+    arena.write(allocation, 0, quantized ? static_cast<const void *>(quantizedVertices.data()) : mesh.vertices.data(),
+                vertexBytes);
+    arena.write(allocation, vertexBytes, indices, indexBytes);
+    MemoryStats::add(MODEL_VERTICES, vertexBytes + indexBytes);
 
+    glGenVertexArrays(1, &vaoID);
 
-    glBufferData(GL_ARRAY_BUFFER, mesh.vertices.size() * sizeof(Vertex), mesh.vertices.data(), GL_STATIC_DRAW);
+    GLStateCache::bindVertexArray(vaoID);
+    GLuint bufferId = arena.getBufferId(arena.getPage(allocation));
+    glBindBuffer(GL_ARRAY_BUFFER, bufferId);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, bufferId);
 
-    // positions
     glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), nullptr);
-
-    // normals
     glEnableVertexAttribArray(1);
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void *) sizeof(glm::vec3));
-
-    // texture coords
     glEnableVertexAttribArray(2);
-    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void *) (sizeof(glm::vec3) * 2));
+    if (quantized) {
+        // the shaders still read vec3/vec2 attributes, the vertex fetch unpacks them
+        glVertexAttribPointer(0, 3, GL_HALF_FLOAT, GL_FALSE, vertexStride,
+                              (void *) offsetof(QuantizedVertex, position));
+        glVertexAttribPointer(1, 4, GL_INT_2_10_10_10_REV, GL_TRUE, vertexStride,
+                              (void *) offsetof(QuantizedVertex, normal));
+        glVertexAttribPointer(2, 2, GL_UNSIGNED_SHORT, GL_TRUE, vertexStride,
+                              (void *) offsetof(QuantizedVertex, textureCoordinate));
+    } else {
+        // positions
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, vertexStride, (void *) offsetof(Vertex, position));
+        // normals
+        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, vertexStride, (void *) offsetof(Vertex, normal));
+        // texture coords
+        glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, vertexStride, (void *) offsetof(Vertex, textureCoordinate));
+    }
 
-    glBindVertexArray(0);
+    GLStateCache::bindVertexArray(0);
 }
 
 void Model::bindBuffers() const {
-    glBindVertexArray(vaoID);
+    GLStateCache::bindVertexArray(vaoID);
 }
 
 void Model::draw() const {
     bindBuffers();
-    glDrawArrays(GL_TRIANGLES, 0, numVertices);
+    // the arena may have moved the range since the last draw
+    GLintptr offset = arena->getOffset(allocation);
+    glDrawElementsBaseVertex(GL_TRIANGLES, static_cast<GLsizei>(numIndices), indexType, (void *) (offset + vertexBytes),
+                             static_cast<GLint>(offset / vertexStride));
+    RenderStats::count(DRAW_CALLS);
+    RenderStats::count(DRAW_COMMANDS);
+    RenderStats::count(VERTICES, numIndices);
 }
 
 void Model::destroyBuffers() {
-    glDeleteBuffers(1, &vboID);
-    glDeleteBuffers(1, &iboId);
+    MemoryStats::remove(MODEL_VERTICES, static_cast<int64_t>(vertexBytes + indexBytes));
+    arena->release(allocation);
+    allocation = BufferArena::INVALID_HANDLE;
     glDeleteVertexArrays(1, &vaoID);
+    GLStateCache::forgetVertexArray(vaoID);
 }
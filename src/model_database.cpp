@@ -1,41 +1,161 @@
 //
 // Created by Willi on 8/5/2020.
 //
+#include <chrono>
 #include "../include/model_database.h"
+#include "../include/logging.h"
+#include "../include/mesh_cache.h"
+#include "../include/mesh_optimizer.h"
+#include "../include/profiler.h"
 
 ModelDatabase ModelDatabase::instance;
 
-ModelDatabase::ModelDatabase() {
-    this->models = std::unordered_map<std::string, std::shared_ptr<Model>>();
-}
+ModelDatabase::ModelDatabase() = default;
 
-void ModelDatabase::init() {
+void ModelDatabase::init(bool quantize, JobSystem &jobs, bool lazy) {
+    PROFILE_FUNCTION();
 
     LOG(INFO) << "Initializing Model Database ...";
+    instance.arena = std::make_unique<BufferArena>(ARENA_PAGE_SIZE);
+    instance.quantize = quantize;
+    instance.lazy = lazy;
+    instance.jobs = &jobs;
 
-    for (const auto &file : fs::directory_iterator(fs::current_path().string() + "/resources/models/")) {
-        LOG(INFO) << "Processing " + file.path().filename().string() + " for model data.";
-
-        // Insert modelName => Model
-        Mesh mesh = makeMeshFromFile("./resources/models/" + file.path().filename().string());
+    // every model is known by name from the start, whether or not it's loaded
+    for (const auto &name : ResourcePack::list("models")) {
+        std::string modelName = fs::path(name).stem().string() + "Model";
+        size_t index = instance.paths.size();
+        instance.modelIndices.insert({modelName, index});
+        instance.paths.push_back("models/" + name);
+        instance.models.emplace_back();
+        instance.residency.add(modelName == ModelType::CUBE);
+    }
 
-        if (file.path().filename().string() == "steve.obj") {
-            mesh.meshName = "steve";
+    for (size_t i = 0; i < instance.paths.size(); i++) {
+        // when lazy, the cube is the only model loaded up front: the others are drawn as a cube until they're loaded
+        if (lazy && i != getModelIndex(ModelType::CUBE))
+            continue;
+        LOG(INFO) << "Processing " + instance.paths[i] + " for model data.";
+        Mesh mesh = loadMesh(instance.paths[i]);
+        instance.addModel(i, mesh);
+        if (lazy) {
+            instance.residency.use(i);
+            instance.residency.loaded(i, instance.models[i]->getVertexBytes() + instance.models[i]->getIndexBytes());
         }
-        std::shared_ptr<Model> model = std::make_shared<Model>(mesh);
-        instance.models.insert({model->getModelName(), model});
+        LOG(INFO) << "Finished processing " + instance.paths[i] + ".";
+    }
+
+    if (lazy) {
+        instance.placeholder = getModelIndex(ModelType::CUBE);
+        LOG(INFO) << instance.paths.size() << " models are loaded on first use, with a budget of "
+                  << EngineConstants::MODEL_RESIDENCY_BUDGET / (1024 * 1024) << " MiB.";
+    }
+}
+
+Mesh ModelDatabase::loadMesh(const std::string &path) {
+    PROFILE_FUNCTION();
+
+    // the .obj is only parsed and optimized when the mesh cache has no entry for this version of it
+    auto loadStart = std::chrono::steady_clock::now();
+    Mesh mesh;
+    bool cached = MeshCache::load(path, mesh);
+    if (!cached) {
+        mesh = makeMeshFromFile(path);
+        float parsedRatio = averageCacheMissRatio(mesh.indices, mesh.vertices.size());
+        optimizeMesh(mesh);
+        LOG(INFO) << "Optimized the index order of " << path << ": "
+                  << parsedRatio << " -> " << averageCacheMissRatio(mesh.indices, mesh.vertices.size())
+                  << " vertices transformed per triangle.";
+        MeshCache::store(path, mesh);
+    }
+    LOG(INFO) << (cached ? "Read " : "Parsed ") << path << " ("
+              << mesh.vertices.size() << " vertices, " << mesh.indices.size() << " indices) in "
+              << std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - loadStart).count()
+              << " us" << (cached ? " from the mesh cache." : ".");
+
+    // the model is named after its file, whatever the objects inside are called
+    mesh.meshName = fs::path(path).stem().string();
+    return mesh;
+}
+
+void ModelDatabase::addModel(size_t index, Mesh &mesh) {
+    std::shared_ptr<Model> model = std::make_shared<Model>(mesh, *arena, quantize);
+    models[index] = model;
+
+    // compared to the non-indexed float vertices the models used to upload
+    auto expandedBytes = static_cast<GLsizeiptr>(mesh.indices.size() * sizeof(Vertex));
+    GLsizeiptr indexedBytes = model->getVertexBytes() + model->getIndexBytes();
+    LOG(INFO) << model->getModelName() << ": " << model->getVertexBytes() << " bytes of "
+              << (model->isQuantized() ? "quantized " : "") << "vertices + " << model->getIndexBytes()
+              << " bytes of indices, instead of " << expandedBytes << " bytes non-indexed ("
+              << (expandedBytes > 0 ? 100.0 * (expandedBytes - indexedBytes) / expandedBytes : 0.0)
+              << "% saved).";
+}
 
-        LOG(INFO) << "Finished processing " + file.path().filename().string() + ".";
+void ModelDatabase::requestLoad(size_t index) {
+    auto mesh = std::make_shared<Mesh>();
+    JobHandle load = jobs->submit([index, mesh]() {
+        *mesh = loadMesh(instance.paths[index]);
+    });
+
+    // the upload needs the context
+    jobs->then(load, [index, mesh]() {
+        PROFILE_SCOPE("Upload model");
+        instance.addModel(index, *mesh);
+        const Model &model = *instance.models[index];
+        instance.residency.loaded(index, model.getVertexBytes() + model.getIndexBytes());
+    }, MAIN_THREAD);
+}
+
+size_t ModelDatabase::getModelIndex(const std::string &modelName) {
+    auto found = instance.modelIndices.find(modelName);
+    return found == instance.modelIndices.end() ? NO_MODEL : found->second;
+}
+
+std::shared_ptr<Model> &ModelDatabase::getModel(size_t index) {
+    if (index >= instance.models.size())
+        return instance.missing;
+    if (instance.lazy) {
+        if (instance.residency.use(index))
+            instance.requestLoad(index);
+        if (!instance.models[index] && instance.placeholder != NO_MODEL)
+            return instance.models[instance.placeholder];
     }
+    return instance.models[index];
 }
 
 std::shared_ptr<Model> &ModelDatabase::getModelByName(const std::string &modelName) {
-    return instance.models[modelName];
+    return getModel(getModelIndex(modelName));
 }
 
-ModelDatabase::~ModelDatabase() {
-    for (auto &pair : models) {
-        pair.second->destroyBuffers();
+void ModelDatabase::update() {
+    if (!instance.lazy)
+        return;
+    for (size_t index : instance.residency.nextFrame()) {
+        ENGINE_LOG(DEBUG) << "Evicted " << instance.models[index]->getModelName() << ".";
+        instance.models[index]->destroyBuffers();
+        instance.models[index].reset();
     }
 }
 
+AssetResidencyStats ModelDatabase::getResidencyStats() {
+    return instance.residency.getStats();
+}
+
+BufferArenaStats ModelDatabase::getArenaStats() {
+    return instance.arena ? instance.arena->getStats() : BufferArenaStats();
+}
+
+void ModelDatabase::destroy() {
+    for (auto &model : instance.models) {
+        if (model)
+            model->destroyBuffers();
+    }
+    instance.models.clear();
+    instance.arena.reset();
+}
+
+ModelDatabase::~ModelDatabase() {
+    // the GL objects are gone with the context by now, unless destroy() wasn't called
+    destroy();
+}
@@ -2,7 +2,10 @@
 // Created by Ewan on 8/8/2020.
 //
 #include "../include/player.h"
+#include "../include/block_registry.h"
 #include "../include/engine.h"
+#include "../include/profiler.h"
+#include "../include/logging.h"
 
 Player::Player() : Entity(ModelType::CUBE, BlockID::PLAYER,
                           Transform({20.0, 30.0, 20.0}, {1, 1, 1}, {0, 0, 0})) {
@@ -21,25 +24,22 @@ void Player::jump() {
     }
 }
 
-void Player::look(GLFWwindow *window, double xpos, double ypos) {
+void Player::look(float deltaX, float deltaY) {
 
-    static double lastXpos = 0.0, lastYpos = 0.0;
-    double changeX = xpos - lastXpos, changeY = ypos - lastYpos;
-
-    this->camera.Pitch -= static_cast<float>(changeY) * 0.5f;
+    this->camera.Pitch -= deltaY * 0.5f;
     if (this->camera.Pitch > 89.0f)
         this->camera.Pitch = 89.0f;
     if (this->camera.Pitch < -89.0f)
         this->camera.Pitch = -89.0f;
 
-    this->camera.Yaw += static_cast<float>(changeX) * 0.5f;
+    this->camera.Yaw += deltaX * 0.5f;
 
     this->camera.updateCameraVectors();
-    glfwGetCursorPos(window, &lastXpos, &lastYpos);
 }
 
 /// Should do any collision/physics here
 void Player::update(Engine *engine, float dt) {
+    PROFILE_FUNCTION();
 
     auto currentChunk = engine->getChunkManager()->getChunkByXZ(
             {getTransform().getPosition().x, getTransform().getPosition().z});
@@ -69,14 +69,15 @@ void Player::update(Engine *engine, float dt) {
         }
 
         // Out of bounds!
-        LOG(INFO) << "Player is out of bounds at x: " << this->getTransform().getPosition().x << " y:"
-                  << this->getTransform().getPosition().y << " z:" << this->getTransform().getPosition().z;
+        ENGINE_LOG_EVERY_MS(INFO, 1000) << "Player is out of bounds at x: " << this->getTransform().getPosition().x
+                                        << " y:" << this->getTransform().getPosition().y << " z:"
+                                        << this->getTransform().getPosition().z;
     }
 
     this->transform.translate(velocity);
 
     if (this->transform.getPosition().y < 0) {
-        LOG(DEBUG) << "Player fell through the world!.";
+        ENGINE_LOG(DEBUG) << "Player fell through the world!.";
         this->transform.getPosition().y = 30.0f;
     }
 
@@ -84,44 +85,19 @@ void Player::update(Engine *engine, float dt) {
     this->camera.Position = this->getTransform().getPosition() + cameraDisplacement;
 }
 
-static bool pressedLMB = false;
-static bool pressedRMB = false;
-
 void Player::processInput(Engine *engine) {
 
-    GLFWwindow *window = engine->getWindow();
+    const Input &input = engine->getInput();
     float speed = 10;
 
-    if (glfwGetKey(window, GLFW_KEY_1) == GLFW_PRESS) {
-        this->selectedBlockID = BlockID::DIRT;
-    }
-    if (glfwGetKey(window, GLFW_KEY_2) == GLFW_PRESS) {
-        this->selectedBlockID = BlockID::DIRT_GRASS;
-    }
-    if (glfwGetKey(window, GLFW_KEY_3) == GLFW_PRESS) {
-        this->selectedBlockID = BlockID::BEDROCK;
-    }
-    if (glfwGetKey(window, GLFW_KEY_4) == GLFW_PRESS) {
-        this->selectedBlockID = BlockID::STONE;
-    }
-    if (glfwGetKey(window, GLFW_KEY_5) == GLFW_PRESS) {
-        this->selectedBlockID = BlockID::OAK_LOG;
-    }
-    if (glfwGetKey(window, GLFW_KEY_6) == GLFW_PRESS) {
-        this->selectedBlockID = BlockID::OAK_LEAVES;
-    }
-    if (glfwGetKey(window, GLFW_KEY_7) == GLFW_PRESS) {
-        this->selectedBlockID = BlockID::WATER;
-    }
-    if (glfwGetKey(window, GLFW_KEY_8) == GLFW_PRESS) {
-        this->selectedBlockID = BlockID::RUBY;
-    }
-    if (glfwGetKey(window, GLFW_KEY_9) == GLFW_PRESS) {
-        this->selectedBlockID = BlockID::GOLD;
+    for (unsigned int slot = 0; slot < BlockRegistry::SLOT_COUNT; slot++) {
+        std::optional<BlockID> block = BlockRegistry::getBlockInSlot(slot);
+        if (block && input.isDown(SELECT_BLOCK_1 << slot))
+            this->selectedBlockID = *block;
     }
 
 
-    if (glfwGetKey(window, GLFW_KEY_0) == GLFW_PRESS) {
+    if (input.isDown(TOGGLE_PERSPECTIVE)) {
 
         if (firstPerson) {
             cameraDisplacement = glm::vec3(0.5f, 5.5f, 5.5f);
@@ -134,7 +110,7 @@ void Player::processInput(Engine *engine) {
     }
 
     // if in third person rotates around model
-    if (glfwGetKey(window, GLFW_KEY_E) == GLFW_PRESS) {
+    if (input.isDown(ROTATE_VIEW)) {
 
         if(!firstPerson){
             float newX = cos(glm::radians(10.0f))* (cameraDisplacement.x) - sin(glm::radians(10.0f))* cameraDisplacement.z;
@@ -144,64 +120,57 @@ void Player::processInput(Engine *engine) {
     }
 
     // movement
-    if (glfwGetKey(window, GLFW_KEY_W) == GLFW_PRESS && glfwGetKey(window, GLFW_KEY_D) == GLFW_PRESS) {
+    if (input.isDown(MOVE_FORWARD) && input.isDown(MOVE_RIGHT)) {
         glm::vec3 dirVec = glm::normalize(camera.Front + camera.Right);
         this->acceleration.x += dirVec.x * speed;
         this->acceleration.z += dirVec.z * speed;
-    } else if (glfwGetKey(window, GLFW_KEY_W) == GLFW_PRESS && glfwGetKey(window, GLFW_KEY_A) == GLFW_PRESS) {
+    } else if (input.isDown(MOVE_FORWARD) && input.isDown(MOVE_LEFT)) {
         glm::vec3 dirVec = glm::normalize(camera.Front + -(camera.Right));
         this->acceleration.x += dirVec.x * speed;
         this->acceleration.z += dirVec.z * speed;
-    } else if (glfwGetKey(window, GLFW_KEY_S) == GLFW_PRESS && glfwGetKey(window, GLFW_KEY_A) == GLFW_PRESS) {
+    } else if (input.isDown(MOVE_BACKWARD) && input.isDown(MOVE_LEFT)) {
         glm::vec3 dirVec = glm::normalize(-(camera.Front) + -(camera.Right));
         this->acceleration.x += dirVec.x * speed;
         this->acceleration.z += dirVec.z * speed;
-    } else if (glfwGetKey(window, GLFW_KEY_S) == GLFW_PRESS && glfwGetKey(window, GLFW_KEY_D) == GLFW_PRESS) {
+    } else if (input.isDown(MOVE_BACKWARD) && input.isDown(MOVE_RIGHT)) {
         glm::vec3 dirVec = glm::normalize(-(camera.Front) + camera.Right);
         this->acceleration.x += dirVec.x * speed;
         this->acceleration.z += dirVec.z * speed;
     } else {
 
-        if (glfwGetKey(window, GLFW_KEY_W) == GLFW_PRESS) {
+        if (input.isDown(MOVE_FORWARD)) {
             this->acceleration.x += camera.Front.x * speed;
             this->acceleration.z += camera.Front.z * speed;
         }
 
-        if (glfwGetKey(window, GLFW_KEY_S) == GLFW_PRESS) {
+        if (input.isDown(MOVE_BACKWARD)) {
             this->acceleration.x += camera.Front.x * -speed;
             this->acceleration.z += camera.Front.z * -speed;
         }
 
-        if (glfwGetKey(window, GLFW_KEY_A) == GLFW_PRESS) {
+        if (input.isDown(MOVE_LEFT)) {
             this->acceleration.x += camera.Right.x * -speed;
             this->acceleration.z += camera.Right.z * -speed;
         }
 
-        if (glfwGetKey(window, GLFW_KEY_D) == GLFW_PRESS) {
+        if (input.isDown(MOVE_RIGHT)) {
             this->acceleration.x += camera.Right.x * speed;
             this->acceleration.z += camera.Right.z * speed;
         }
 
-        if (glfwGetKey(window, GLFW_KEY_SPACE) == GLFW_PRESS) {
+        if (input.isDown(JUMP)) {
             this->jump();
         }
     }
 
     // place / remove blocks
-    if (glfwGetMouseButton(window, GLFW_MOUSE_BUTTON_LEFT) == GLFW_PRESS && !pressedLMB) {
-        pressedLMB = true;
+    if (input.wasPressed(BREAK_BLOCK)) {
         this->removeEntity(engine);
     }
 
-    if (glfwGetMouseButton(window, GLFW_MOUSE_BUTTON_RIGHT) == GLFW_PRESS && !pressedRMB) {
-        pressedRMB = true;
+    if (input.wasPressed(PLACE_BLOCK)) {
         this->placeBlock(engine);
     }
-
-    if (glfwGetMouseButton(window, GLFW_MOUSE_BUTTON_LEFT) == GLFW_RELEASE)
-        pressedLMB = false;
-    if (glfwGetMouseButton(window, GLFW_MOUSE_BUTTON_RIGHT) == GLFW_RELEASE)
-        pressedRMB = false;
 }
 
 void Player::collide(const std::shared_ptr<Chunk> &currentChunk) {
@@ -253,7 +222,8 @@ void Player::removeEntity(Engine *engine) const {
 
         if (closestEnt.has_value()) {
             BlockID toRemoveID = (*closestEnt)->getBlockID();
-            if (toRemoveID != BEDROCK && engine->getChunkManager()->removeEntityFromChunk(*closestEnt.value())) {
+            if (BlockRegistry::get(toRemoveID).breakable &&
+                engine->getChunkManager()->removeEntityFromChunk(*closestEnt.value())) {
                 SoundDatabase::playSoundByName("pop.mp3");
                 LOG(DEBUG) << "Removed " << toRemoveID << " from the world.";
                 return;
@@ -284,46 +254,10 @@ void Player::placeBlock(Engine *engine) {
             (*chunk)->addEntity(Entity(ModelType::CUBE, selectedBlockID,
                                        Transform(newBlockPlacement, glm::vec3(1, 1, 1), glm::vec3(0, 0, 0))));
 
-            switch (selectedBlockID) {
-                case DIRT:
-                case DIRT_GRASS:
-                    SoundDatabase::playSoundByName("place-block-grass.mp3");
-                    break;
-                case OAK_LOG:
-                    SoundDatabase::playSoundByName("place-block-wood.mp3");
-                    break;
-                case OAK_LEAVES:
-                    SoundDatabase::playSoundByName("place-block-cloth.mp3");
-                    break;
-                case WATER:
-                    SoundDatabase::playSoundByName("water-splash.mp3");
-                    break;
-                case STONE:
-                case RUBY:
-                case GOLD:
-                default:
-                    SoundDatabase::playSoundByName("place-block-stone.mp3");
-                    break;
-            }
+            std::string_view placeSound = BlockRegistry::get(selectedBlockID).placeSound;
+            if (!placeSound.empty())
+                SoundDatabase::playSoundByName(std::string(placeSound));
             return;
         }
     }
 }
-
-void Player::draw(Shader &shader) {
-
-    shader.setMat4("model", this->transform.getModelMatrix());
-
-    // Get texture and bind
-    this->tex->bindTexture();
-    if (this->tex->getTextureType() == CUBEMAP) {
-        shader.setBool("isCubeMap", true);
-        shader.setInt("textureCubeMap", 1);
-    } else {
-        shader.setBool("isCubeMap", false);
-        shader.setInt("texture2D", 0);
-    }
-
-    // Get Model and draw
-    this->model->draw();
-}
@@ -0,0 +1,99 @@
+//
+// Created on 10/19/2026.
+//
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include "../libs/easylogging++.h"
+#include "../include/profiler.h"
+
+Profiler Profiler::instance;
+
+/// Monotonic time in nanoseconds
+static uint64_t steadyNanoseconds() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+/// Escapes the characters that can't appear as is in a JSON string
+static std::string escapeJson(const std::string &text) {
+    std::string out;
+    out.reserve(text.size());
+    for (char c : text) {
+        if (c == '"' || c == '\\')
+            out += '\\';
+        out += c;
+    }
+    return out;
+}
+
+Profiler::Profiler() {
+    this->epoch = steadyNanoseconds();
+}
+
+uint64_t Profiler::now() {
+    return steadyNanoseconds() - instance.epoch;
+}
+
+Profiler::ThreadBuffer &Profiler::getThreadBuffer() {
+    static thread_local ThreadBuffer *buffer = nullptr;
+    if (buffer == nullptr) {
+        auto created = std::make_shared<ThreadBuffer>();
+        created->events = std::make_unique<ProfileEvent[]>(EVENTS_PER_THREAD);
+
+        std::lock_guard<std::mutex> lock(instance.buffersMutex);
+        created->threadId = static_cast<unsigned int>(instance.buffers.size());
+        created->threadName = created->threadId == 0 ? "Main" : "Thread " + std::to_string(created->threadId);
+        instance.buffers.push_back(created);
+        buffer = created.get();
+    }
+    return *buffer;
+}
+
+void Profiler::record(const char *name, uint64_t start, uint64_t end) {
+    ThreadBuffer &buffer = getThreadBuffer();
+    uint64_t index = buffer.written.load(std::memory_order_relaxed);
+    buffer.events[index % EVENTS_PER_THREAD] = {name, start, end - start};
+    buffer.written.store(index + 1, std::memory_order_release);
+}
+
+void Profiler::setThreadName(const std::string &name) {
+    ThreadBuffer &buffer = getThreadBuffer();
+    std::lock_guard<std::mutex> lock(instance.buffersMutex);
+    buffer.threadName = name;
+}
+
+bool Profiler::writeChromeTrace(const std::string &path) {
+
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        LOG(WARNING) << "Could not open " << path << " to write the profiler trace.";
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(instance.buffersMutex);
+    size_t eventCount = 0;
+
+    // timestamps are in microseconds in the trace event format
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[" << std::fixed << std::setprecision(3);
+    bool first = true;
+    for (const auto &buffer : instance.buffers) {
+        file << (first ? "" : ",") << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << buffer->threadId
+             << ",\"args\":{\"name\":\"" << escapeJson(buffer->threadName) << "\"}}";
+        first = false;
+
+        uint64_t written = buffer->written.load(std::memory_order_acquire);
+        uint64_t oldest = written > EVENTS_PER_THREAD ? written - EVENTS_PER_THREAD : 0;
+        for (uint64_t i = oldest; i < written; i++) {
+            const ProfileEvent &event = buffer->events[i % EVENTS_PER_THREAD];
+            file << ",\n{\"name\":\"" << escapeJson(event.name) << "\",\"ph\":\"X\",\"pid\":0,\"tid\":"
+                 << buffer->threadId << ",\"ts\":" << static_cast<double>(event.start) / 1000.0
+                 << ",\"dur\":" << static_cast<double>(event.duration) / 1000.0 << "}";
+            eventCount++;
+        }
+    }
+    file << "\n]}\n";
+
+    LOG(INFO) << "Wrote " << eventCount << " profiler events to " << path << ".";
+    return true;
+}
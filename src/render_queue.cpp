@@ -0,0 +1,155 @@
+//
+// Created on 10/19/2026.
+//
+#include <array>
+#include <algorithm>
+#include "../include/render_queue.h"
+#include "../include/engine_constants.h"
+#include "../include/gl_state.h"
+#include "../include/render_stats.h"
+
+static constexpr uint64_t DEPTH_BITS = 28;
+static constexpr uint64_t DEPTH_MASK = (1ull << DEPTH_BITS) - 1;
+
+uint64_t RenderQueue::makeSortKey(RenderPass pass, GLuint program, GLuint texture, GLuint vao, float viewDepth) {
+
+    float normalizedDepth = std::clamp(viewDepth / EngineConstants::FAR_PLANE, 0.0f, 1.0f);
+    auto depth = static_cast<uint64_t>(normalizedDepth * static_cast<float>(DEPTH_MASK)) & DEPTH_MASK;
+
+    // object names only need to group equal state together, so collisions merely cost a bit of batching
+    uint64_t state = ((uint64_t) (program & 0xFFu) << 24u) | ((uint64_t) (texture & 0xFFFu) << 12u) |
+                     (uint64_t) (vao & 0xFFFu);
+
+    uint64_t key = (uint64_t) pass << 60u;
+    if (pass == TRANSLUCENT_PASS) {
+        key |= (DEPTH_MASK - depth) << 32u;
+        key |= state;
+    } else {
+        key |= state << DEPTH_BITS;
+        key |= depth;
+    }
+    return key;
+}
+
+void RenderQueue::submit(RenderPass pass, Shader &shader, TextureInterface *texture, const Drawable &drawable,
+                         const glm::mat4 *modelMatrix, float viewDepth, float opacity) {
+    DrawPacket packet;
+    packet.shader = &shader;
+    packet.texture = texture;
+    packet.drawable = &drawable;
+    packet.modelMatrix = modelMatrix;
+    packet.opacity = opacity;
+    packet.sortKey = makeSortKey(pass, shader.ID, texture ? texture->getTexId() : 0, drawable.getVaoId(),
+                                 viewDepth);
+    packets.push_back(packet);
+}
+
+void RenderQueue::sort() {
+
+    const size_t count = packets.size();
+    sorted.resize(count);
+    scratch.resize(count);
+    for (uint32_t i = 0; i < count; i++) {
+        sorted[i] = {packets[i].sortKey, i};
+    }
+    if (count < 2)
+        return;
+
+    // LSD radix sort, one byte per pass
+    for (unsigned int shift = 0; shift < 64; shift += 8) {
+        std::array<size_t, 256> offsets{};
+        for (const auto &entry : sorted) {
+            offsets[(entry.key >> shift) & 0xFFu]++;
+        }
+        // every key shares this byte, nothing to reorder
+        if (offsets[(sorted[0].key >> shift) & 0xFFu] == count)
+            continue;
+
+        size_t total = 0;
+        for (auto &offset : offsets) {
+            size_t bucketSize = offset;
+            offset = total;
+            total += bucketSize;
+        }
+        for (const auto &entry : sorted) {
+            scratch[offsets[(entry.key >> shift) & 0xFFu]++] = entry;
+        }
+        sorted.swap(scratch);
+    }
+}
+
+void RenderQueue::applyPassState(RenderPass pass) {
+    switch (pass) {
+        case SKY_PASS:
+            GLStateCache::depthFunc(GL_LEQUAL);
+            GLStateCache::depthMask(true);
+            GLStateCache::setCapability(GL_CULL_FACE, false);
+            GLStateCache::setCapability(GL_BLEND, false);
+            break;
+        case TRANSLUCENT_PASS:
+            // blended surfaces are visible from both sides and must not hide each other
+            GLStateCache::depthFunc(GL_LESS);
+            GLStateCache::depthMask(false);
+            GLStateCache::setCapability(GL_CULL_FACE, false);
+            GLStateCache::setCapability(GL_BLEND, true);
+            break;
+        case OPAQUE_PASS:
+        default:
+            GLStateCache::depthFunc(GL_LESS);
+            GLStateCache::depthMask(true);
+            GLStateCache::setCapability(GL_CULL_FACE, true);
+            GLStateCache::setCapability(GL_BLEND, false);
+            break;
+    }
+}
+
+void RenderQueue::execute() {
+
+    int currentPass = -1;
+    Shader *currentShader = nullptr;
+    TextureInterface *currentTexture = nullptr;
+    float currentOpacity = -1.0f;
+
+    for (const auto &entry : sorted) {
+        const DrawPacket &packet = packets[entry.index];
+
+        RenderPass pass = getPassFromKey(packet.sortKey);
+        if (pass != currentPass) {
+            applyPassState(pass);
+            RenderStats::setPass(pass);
+            currentPass = pass;
+        }
+
+        if (packet.shader != currentShader) {
+            packet.shader->use();
+            currentShader = packet.shader;
+            currentTexture = nullptr;
+            currentOpacity = -1.0f;
+        }
+
+        if (packet.opacity != currentOpacity) {
+            packet.shader->setFloat("alpha", packet.opacity);
+            currentOpacity = packet.opacity;
+        }
+
+        if (packet.texture != nullptr && packet.texture != currentTexture) {
+            packet.texture->bindTexture();
+            packet.shader->setBool("isCubeMap", packet.texture->getTextureType() == CUBEMAP);
+            currentTexture = packet.texture;
+        }
+
+        if (packet.modelMatrix != nullptr)
+            packet.shader->setMat4("model", *packet.modelMatrix);
+
+        packet.drawable->draw();
+    }
+
+    // leave the default state behind for anything drawn outside the queue
+    applyPassState(OPAQUE_PASS);
+    RenderStats::setPass(OUTSIDE_PASS);
+}
+
+void RenderQueue::clear() {
+    packets.clear();
+    sorted.clear();
+}
@@ -0,0 +1,58 @@
+//
+// Created on 10/19/2026.
+//
+#include "../libs/easylogging++.h"
+#include "../include/render_stats.h"
+
+RenderStats RenderStats::instance;
+
+/// Name of a counter slot in the logs
+static const char *getPassName(unsigned int pass) {
+    switch (pass) {
+        case OPAQUE_PASS:
+            return "opaque";
+        case SKY_PASS:
+            return "sky";
+        case TRANSLUCENT_PASS:
+            return "translucent";
+        default:
+            return "outside";
+    }
+}
+
+void RenderStats::beginFrame() {
+    instance.lastFrame = instance.currentFrame;
+    instance.currentFrame = RenderCounters();
+    instance.pass = OUTSIDE_PASS;
+    instance.frameIndex++;
+
+    if (instance.logInterval != 0 && instance.frameIndex % instance.logInterval == 0)
+        instance.logLastFrame();
+}
+
+void RenderStats::setLogInterval(unsigned int frames) {
+    instance.logInterval = frames;
+}
+
+const RenderCounters &RenderStats::getFrameCounters() {
+    return instance.lastFrame;
+}
+
+const RenderCounters &RenderStats::getCurrentCounters() {
+    return instance.currentFrame;
+}
+
+void RenderStats::logLastFrame() const {
+    LOG(INFO) << "Frame " << frameIndex - 1 << ": " << lastFrame.get(DRAW_CALLS) << " draw calls ("
+              << lastFrame.get(DRAW_COMMANDS) << " draws), " << lastFrame.get(VERTICES) << " vertices, "
+              << lastFrame.get(TEXTURE_BINDS) << " texture binds, " << lastFrame.get(SHADER_BINDS)
+              << " shader binds, " << lastFrame.get(UNIFORM_UPDATES) << " uniform updates, "
+              << lastFrame.get(FRUSTUM_TESTS) << " frustum tests (" << lastFrame.get(FRUSTUM_CULLED) << " culled)";
+
+    for (unsigned int pass = 0; pass <= OUTSIDE_PASS; pass++) {
+        LOG(INFO) << "  " << getPassName(pass) << ": " << lastFrame.get(DRAW_CALLS, pass) << " draw calls, "
+                  << lastFrame.get(VERTICES, pass) << " vertices, " << lastFrame.get(TEXTURE_BINDS, pass)
+                  << " texture binds, " << lastFrame.get(SHADER_BINDS, pass) << " shader binds, "
+                  << lastFrame.get(UNIFORM_UPDATES, pass) << " uniform updates";
+    }
+}
@@ -0,0 +1,180 @@
+//
+// Created on 10/19/2026.
+//
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include "../libs/easylogging++.h"
+#include "../include/resource_pack.h"
+#include "../include/engine_constants.h"
+
+ResourcePack ResourcePack::instance;
+
+static constexpr char RESOURCE_PACK_MAGIC[4] = {'R', 'P', 'A', 'K'};
+static constexpr uint32_t RESOURCE_PACK_VERSION = 1;
+
+struct ResourcePackHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t entryCount;
+    uint32_t padding;
+};
+
+struct ResourcePackEntry {
+    uint64_t dataOffset;
+    uint64_t dataSize;
+    uint32_t pathOffset;
+    uint32_t pathLength;
+};
+
+Resource &Resource::operator=(Resource &&other) noexcept {
+    if (this != &other) {
+        // a view into the other's own string has to point into ours once it's moved
+        bool ownsBytes = !other.owned.empty() && other.bytes.data() == other.owned.data();
+        owned = std::move(other.owned);
+        bytes = ownsBytes ? std::string_view(owned) : other.bytes;
+        found = other.found;
+        other.bytes = {};
+        other.found = false;
+    }
+    return *this;
+}
+
+ResourcePack::~ResourcePack() {
+    // views into the pack (i.e. the sounds irrKlang plays from memory) may be used until the very end, the mapping is
+    // left for the OS to release when the process exits
+    static_cast<void>(pack.release());
+}
+
+bool ResourcePack::openPack(const std::filesystem::path &path) {
+    auto file = std::make_unique<MappedFile>(path.string());
+    if (!file->isOpen() || file->getSize() < sizeof(ResourcePackHeader))
+        return false;
+
+    const unsigned char *data = file->getData();
+    size_t size = file->getSize();
+    ResourcePackHeader header{};
+    std::memcpy(&header, data, sizeof(header));
+    if (std::memcmp(header.magic, RESOURCE_PACK_MAGIC, sizeof(header.magic)) != 0 ||
+        header.version != RESOURCE_PACK_VERSION ||
+        sizeof(header) + static_cast<size_t>(header.entryCount) * sizeof(ResourcePackEntry) > size) {
+        LOG(WARNING) << path << " is not a valid resource pack.";
+        return false;
+    }
+
+    entries.clear();
+    paths.clear();
+    for (uint32_t i = 0; i < header.entryCount; i++) {
+        ResourcePackEntry entry{};
+        std::memcpy(&entry, data + sizeof(header) + i * sizeof(ResourcePackEntry), sizeof(entry));
+        if (static_cast<uint64_t>(entry.pathOffset) + entry.pathLength > size || entry.dataOffset > size ||
+            entry.dataSize > size - entry.dataOffset) {
+            LOG(WARNING) << path << " is damaged, entry " << i << " is out of the file.";
+            entries.clear();
+            paths.clear();
+            return false;
+        }
+        std::string_view name(reinterpret_cast<const char *>(data + entry.pathOffset), entry.pathLength);
+        entries[name] = std::string_view(reinterpret_cast<const char *>(data + entry.dataOffset), entry.dataSize);
+        paths.push_back(name);
+    }
+    std::sort(paths.begin(), paths.end());
+
+    std::error_code error;
+    packTime = static_cast<int64_t>(std::filesystem::last_write_time(path, error).time_since_epoch().count());
+    pack = std::move(file);
+    return true;
+}
+
+bool ResourcePack::init(const char *executablePath) {
+    // the working directory first, then the executable's folder, so the game can be started from anywhere
+    std::vector<std::filesystem::path> folders = {std::filesystem::current_path()};
+    std::error_code error;
+    std::filesystem::path executable = std::filesystem::absolute(executablePath, error);
+    if (!error && executable.has_parent_path())
+        folders.push_back(executable.parent_path());
+
+    for (const auto &folder : folders) {
+        std::filesystem::path path = folder / EngineConstants::RESOURCE_PACK_PATH;
+        if (std::filesystem::exists(path, error) && instance.openPack(path)) {
+            LOG(INFO) << "Loading resources from " << path.string() << " (" << instance.entries.size() << " files, "
+                      << instance.pack->getSize() / 1024 << " KiB).";
+            return true;
+        }
+    }
+    for (const auto &folder : folders) {
+        std::filesystem::path path = folder / "resources";
+        if (std::filesystem::is_directory(path, error)) {
+            instance.looseRoot = path;
+            LOG(INFO) << "No resource pack, loading the loose files of " << path.string() << ".";
+            return true;
+        }
+    }
+    LOG(ERROR) << "Found neither " << EngineConstants::RESOURCE_PACK_PATH << " nor a resources folder.";
+    return false;
+}
+
+bool ResourcePack::isPacked() {
+    return instance.pack != nullptr;
+}
+
+std::string ResourcePack::getLoosePath(const std::string &path) {
+    return instance.pack ? std::string() : (instance.looseRoot / path).string();
+}
+
+Resource ResourcePack::load(const std::string &path) {
+    if (instance.pack) {
+        auto entry = instance.entries.find(path);
+        return entry == instance.entries.end() ? Resource() : Resource(entry->second);
+    }
+
+    std::ifstream file(instance.looseRoot / path, std::ios::binary);
+    if (!file.is_open())
+        return {};
+    std::ostringstream content;
+    content << file.rdbuf();
+    return Resource(content.str());
+}
+
+std::vector<std::string> ResourcePack::list(const std::string &folder) {
+    std::vector<std::string> names;
+    if (instance.pack) {
+        // the paths are sorted, so the folder's files are next to each other
+        std::string prefix = folder + "/";
+        auto first = std::lower_bound(instance.paths.begin(), instance.paths.end(), std::string_view(prefix));
+        for (auto path = first; path != instance.paths.end() && path->substr(0, prefix.size()) == prefix; path++) {
+            std::string_view name = path->substr(prefix.size());
+            if (name.find('/') == std::string_view::npos)
+                names.emplace_back(name);
+        }
+        return names;
+    }
+
+    std::error_code error;
+    for (const auto &file : std::filesystem::directory_iterator(instance.looseRoot / folder, error)) {
+        if (file.is_regular_file())
+            names.push_back(file.path().filename().string());
+    }
+    std::sort(names.begin(), names.end());
+    return names;
+}
+
+bool ResourcePack::describe(const std::string &path, uint64_t &size, int64_t &time) {
+    if (instance.pack) {
+        auto entry = instance.entries.find(path);
+        if (entry == instance.entries.end())
+            return false;
+        size = entry->second.size();
+        time = instance.packTime;
+        return true;
+    }
+
+    std::error_code error;
+    std::filesystem::path file = instance.looseRoot / path;
+    size = std::filesystem::file_size(file, error);
+    if (error)
+        return false;
+    time = static_cast<int64_t>(std::filesystem::last_write_time(file, error).time_since_epoch().count());
+    return !error;
+}
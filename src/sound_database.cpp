@@ -2,48 +2,173 @@
 // Created by Willi on 8/20/2020.
 //
 #include "../include/sound_database.h"
+#include "../include/logging.h"
+#include "../include/profiler.h"
+#include "../include/memory_stats.h"
+#include "../include/resource_pack.h"
 
 SoundDatabase SoundDatabase::instance;
 
-void SoundDatabase::init() {
+void SoundDatabase::init(bool lazy) {
+    PROFILE_FUNCTION();
 
     LOG(INFO) << "Initializing Sound Database ...";
+    instance.lazy = lazy;
 
-    for (const auto &file : fs::directory_iterator(fs::current_path().string() + "/resources/sounds/")) {
-        LOG(INFO) << "Processing " + file.path().filename().string() + " for sound data.";
+    unsigned int musicCount = 0;
+    for (const auto &name : ResourcePack::list("sounds")) {
+        uint64_t size = 0;
+        int64_t time = 0;
+        ResourcePack::describe("sounds/" + name, size, time);
+        SoundKind kind = size >= EngineConstants::SOUND_STREAMING_THRESHOLD ? SOUND_MUSIC : SOUND_EFFECT;
+        if (kind == SOUND_MUSIC)
+            musicCount++;
 
-        instance.sounds[file.path().filename().string()] = std::shared_ptr<irrklang::ISoundSource>(
-                instance.soundEngine->addSoundSourceFromFile(file.path().string().c_str()));
+        instance.soundIndices[name] = instance.names.size();
+        instance.names.push_back(name);
+        instance.kinds.push_back(kind);
+        instance.sounds.emplace_back();
+        instance.residency.add(kind == SOUND_EFFECT);
+    }
+    LOG(INFO) << instance.names.size() - musicCount << " sound effects, " << musicCount << " music tracks (from "
+              << EngineConstants::SOUND_STREAMING_THRESHOLD / 1024 << " KiB on).";
 
-        LOG(INFO) << "Finished processing " + file.path().filename().string() + ".";
+    // effects are decoded here even when lazy, decoding one on the frame thread would stall it
+    int64_t decodedBytes = 0;
+    for (size_t i = 0; i < instance.names.size(); i++) {
+        if (lazy && instance.kinds[i] == SOUND_MUSIC)
+            continue;
+        bool registered = instance.registerSound(i);
+        int64_t bytes = registered ? getDecodedBytes(instance.sounds[i].get()) : 0;
+        decodedBytes += bytes;
+        if (lazy) {
+            instance.residency.use(i);
+            if (registered)
+                instance.residency.loaded(i, bytes);
+            else
+                instance.residency.failed(i);
+        }
     }
+    LOG(INFO) << "Preloaded the sound effects: " << decodedBytes / 1024 << " KiB decoded.";
+    if (lazy)
+        LOG(INFO) << musicCount << " music tracks are registered on first use.";
 }
 
-void SoundDatabase::playSoundByName(const std::string &name, bool looped) {
+bool SoundDatabase::registerSound(size_t index) {
+    const std::string &name = names[index];
+    ENGINE_LOG(DEBUG) << "Processing " + name + " for sound data.";
+
+    irrklang::ISoundSource *source = nullptr;
+    std::string loosePath = ResourcePack::getLoosePath("sounds/" + name);
+    if (kinds[index] == SOUND_MUSIC && !loosePath.empty()) {
+        // a loose track is streamed from its file, only a small buffer of it is ever in memory
+        source = soundEngine->addSoundSourceFromFile(loosePath.c_str(), irrklang::ESM_STREAMING);
+    } else {
+        // a packed sound is played straight from the mapping, which outlives the engine, a loose one is copied
+        Resource file = ResourcePack::load("sounds/" + name);
+        source = soundEngine->addSoundSourceFromMemory(
+                const_cast<char *>(file.getData()), static_cast<irrklang::ik_s32>(file.getSize()), name.c_str(),
+                !ResourcePack::isPacked());
+    }
+    if (!source) {
+        LOG(WARNING) << "Could not register " << name << ".";
+        return false;
+    }
+
+    if (kinds[index] == SOUND_MUSIC) {
+        // a packed track is decoded from the mapping, whose pages the OS can drop again once they've been played
+        source->setStreamMode(irrklang::ESM_STREAMING);
+    } else {
+        // irrKlang has no preload for memory sources, but starting one paused decodes it
+        source->setStreamMode(irrklang::ESM_NO_STREAMING);
+        irrklang::ISound *sound = soundEngine->play2D(source, false, true, true);
+        if (sound) {
+            sound->stop();
+            sound->drop();
+        }
+    }
+
+    // the engine owns its sources and frees them when they're removed or when it's dropped
+    sounds[index] = std::shared_ptr<irrklang::ISoundSource>(source, [](irrklang::ISoundSource *) {});
+
+    ENGINE_LOG(DEBUG) << "Finished processing " + name + ".";
+    return true;
+}
+
+std::shared_ptr<irrklang::ISoundSource> SoundDatabase::findSound(const std::string &name) {
+    auto found = soundIndices.find(name);
+    if (found == soundIndices.end())
+        return nullptr;
+
+    size_t index = found->second;
+    // only music is left unregistered: a track is streamed, so registering it opens the loose file or points into the
+    // mapped pack, and irrKlang decodes it on its own thread as it plays
+    if (lazy && residency.use(index)) {
+        if (registerSound(index))
+            residency.loaded(index, getDecodedBytes(sounds[index].get()));
+        else
+            residency.failed(index);
+    }
+    return sounds[index];
+}
 
-    if (instance.sounds.find(name) == instance.sounds.end()) {
+void SoundDatabase::playSoundByName(const std::string &name, bool looped) {
+    std::shared_ptr<irrklang::ISoundSource> sound = instance.findSound(name);
+    if (!sound) {
         LOG(INFO) << "Did not find sound by name " << name;
         return;
-    } else {
-        instance.soundEngine->play2D(instance.sounds[name].get(), looped);
     }
+    instance.soundEngine->play2D(sound.get(), looped);
 }
 
 std::optional<std::shared_ptr<irrklang::ISoundSource>> SoundDatabase::getSoundSourceByName(const std::string &name) {
-    if (instance.sounds.find(name) == instance.sounds.end()) {
+    std::shared_ptr<irrklang::ISoundSource> sound = instance.findSound(name);
+    if (!sound) {
         return {};
     } else {
-        return {instance.sounds[name]};
+        return {sound};
+    }
+}
+
+void SoundDatabase::update() {
+    // there is no budget: effects are pinned and tracks take no decoded bytes, so nothing is ever evicted
+    if (instance.lazy)
+        instance.residency.nextFrame();
+}
+
+AssetResidencyStats SoundDatabase::getResidencyStats() {
+    return instance.residency.getStats();
+}
+
+int64_t SoundDatabase::getDecodedBytes(irrklang::ISoundSource *source) {
+    // streamed sources only keep a small buffer, however long they are
+    if (source->getStreamMode() != irrklang::ESM_NO_STREAMING)
+        return 0;
+    return source->getAudioFormat().getSampleDataSize();
+}
+
+void SoundDatabase::measureMemory() {
+    int64_t bytes = 0, count = 0;
+    for (const auto &sound : instance.sounds) {
+        if (!sound)
+            continue;
+        count++;
+        bytes += getDecodedBytes(sound.get());
     }
+    MemoryStats::set(SOUNDS, bytes, count);
 }
 
 SoundDatabase::SoundDatabase() {
     LOG(INFO) << "Creating irrKLang device";
-    this->soundEngine = std::unique_ptr<irrklang::ISoundEngine>(irrklang::createIrrKlangDevice());
+    // ESEO_MULTI_THREADED, one of the default options, makes irrKlang stream and decode on its own thread; without it
+    // the streams would be decoded by update() calls from the frame thread
+    this->soundEngine = std::unique_ptr<irrklang::ISoundEngine>(
+            irrklang::createIrrKlangDevice(irrklang::ESOD_AUTO_DETECT, irrklang::ESEO_DEFAULT_OPTIONS));
 }
 
 SoundDatabase::~SoundDatabase() {
-    for (auto &pair : sounds) {
-        pair.second->drop();
-    }
+    // irrKlang objects are reference counted: dropping the engine frees it along with every source it still holds
+    sounds.clear();
+    if (soundEngine)
+        soundEngine.release()->drop();
 }
@@ -0,0 +1,64 @@
+//
+// Created on 10/19/2026.
+//
+#include <fstream>
+#include <iomanip>
+#include "../libs/easylogging++.h"
+#include "../include/startup_report.h"
+
+StartupReport StartupReport::instance;
+
+void StartupReport::begin() {
+    instance.start = Clock::now();
+    instance.stages.clear();
+    instance.firstFrameMs = -1.0;
+}
+
+double StartupReport::elapsedMs() {
+    return std::chrono::duration<double, std::milli>(Clock::now() - instance.start).count();
+}
+
+void StartupReport::addStage(const std::string &name, double startMs, double durationMs) {
+    instance.stages.push_back({name, startMs, durationMs});
+}
+
+void StartupReport::markFirstFrame() {
+    if (instance.firstFrameMs < 0.0)
+        instance.firstFrameMs = elapsedMs();
+}
+
+bool StartupReport::hasFirstFrame() {
+    return instance.firstFrameMs >= 0.0;
+}
+
+void StartupReport::logSummary() {
+    LOG(INFO) << "Startup:";
+    for (const auto &stage : instance.stages) {
+        LOG(INFO) << "  " << stage.name << ": " << std::fixed << std::setprecision(1) << stage.durationMs << " ms";
+    }
+    LOG(INFO) << "  first frame after " << std::fixed << std::setprecision(1) << instance.firstFrameMs << " ms";
+}
+
+bool StartupReport::write(const std::string &path) {
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        LOG(WARNING) << "Could not open " << path << " to write the startup report.";
+        return false;
+    }
+
+    file << std::fixed << std::setprecision(3);
+    file << "{\n";
+    file << "  \"build\": \"" << __DATE__ << " " << __TIME__ << "\",\n";
+    file << "  \"timeToFirstFrameMs\": " << instance.firstFrameMs << ",\n";
+    file << "  \"stages\": [";
+    for (size_t i = 0; i < instance.stages.size(); i++) {
+        const auto &stage = instance.stages[i];
+        file << (i == 0 ? "\n" : ",\n");
+        file << "    {\"name\": \"" << stage.name << "\", \"startMs\": " << stage.startMs << ", \"durationMs\": "
+             << stage.durationMs << "}";
+    }
+    file << "\n  ]\n}\n";
+
+    LOG(INFO) << "Wrote the startup report to " << path << ".";
+    return true;
+}
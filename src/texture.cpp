@@ -1,174 +1,273 @@
 //
 // Created by Willi on 7/30/2020.
 //
+#include <algorithm>
 #include "../include/texture.h"
+#include "../include/gl_state.h"
+#include "../include/render_stats.h"
+#include "../include/resource_pack.h"
+#include "../include/texture_uploader.h"
 
+DecodedImage::DecodedImage(const std::string &filePath) {
+    Resource file = ResourcePack::load(filePath);
+    if (file.isValid())
+        pixels = stbi_load_from_memory(reinterpret_cast<const stbi_uc *>(file.getData()),
+                                       static_cast<int>(file.getSize()), &width, &height, &channels, 0);
+    if (!pixels) {
+        std::cout << "Failed to load texture " + filePath << std::endl;
+        return;
+    }
+    MemoryStats::add(TEXTURE_STAGING, getBytes());
+}
 
-void Texture2D::loadFromFile(const std::string &filePath) {
-    GLuint tempId = 0;
-    glGenTextures(1, &tempId);
-    setTexId(tempId);
-    glBindTexture(GL_TEXTURE_2D, getTexId());
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-    // set texture filtering parameters
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-    // load image, create texture and generate mipmaps
-    int width, height, nrChannels;
-    unsigned char *data = stbi_load(filePath.c_str(), &width, &height, &nrChannels, 0);
-    if (!data) {
-        std::cout << "Failed to load texture" << std::endl;
-        texID = 0;
+DecodedImage::~DecodedImage() {
+    if (pixels) {
+        stbi_image_free(pixels);
+        MemoryStats::remove(TEXTURE_STAGING, getBytes());
+    }
+}
+
+DecodedImage::DecodedImage(DecodedImage &&other) noexcept {
+    *this = std::move(other);
+}
+
+DecodedImage &DecodedImage::operator=(DecodedImage &&other) noexcept {
+    if (this != &other) {
+        std::swap(pixels, other.pixels);
+        std::swap(width, other.width);
+        std::swap(height, other.height);
+        std::swap(channels, other.channels);
+    }
+    return *this;
+}
+
+/// Reads one pixel of a decoded image as RGBA, grey and grey-alpha images are expanded
+static void readPixel(const DecodedImage &image, int x, int y, unsigned char rgba[4]) {
+    int channels = image.getChannels();
+    const unsigned char *pixel = image.getPixels() + (static_cast<size_t>(y) * image.getWidth() + x) * channels;
+    if (channels < 3) {
+        rgba[0] = rgba[1] = rgba[2] = pixel[0];
+        rgba[3] = channels == 2 ? pixel[1] : 255;
+    } else {
+        rgba[0] = pixel[0];
+        rgba[1] = pixel[1];
+        rgba[2] = pixel[2];
+        rgba[3] = channels == 4 ? pixel[3] : 255;
+    }
+}
+
+MipmappedImage::MipmappedImage(const DecodedImage &image) {
+    if (!image.isValid())
         return;
+
+    // an alpha channel is kept only if the image had one
+    bool alpha = image.getChannels() == 2 || image.getChannels() == 4;
+    int channels = alpha ? 4 : 3;
+    format = internalFormat = alpha ? GL_RGBA : GL_RGB;
+
+    ImageLevel base{image.getWidth(), image.getHeight(), {}};
+    base.data.resize(static_cast<size_t>(base.width) * base.height * channels);
+    unsigned char rgba[4];
+    for (int y = 0; y < base.height; y++) {
+        for (int x = 0; x < base.width; x++) {
+            readPixel(image, x, y, rgba);
+            std::copy(rgba, rgba + channels, &base.data[(static_cast<size_t>(y) * base.width + x) * channels]);
+        }
     }
-    GLenum format = 0;
-    if (nrChannels == 1) {
-        format = GL_RED; //oof
-    } else if (nrChannels == 3)
-        format = GL_RGB;
-    else if (nrChannels == 4)
-        format = GL_RGBA;
+    levels.push_back(std::move(base));
 
-    glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
+    // each level averages 2x2 pixels of the previous one, the last row or column is repeated for odd sizes
+    while (levels.back().width > 1 || levels.back().height > 1) {
+        const ImageLevel &source = levels.back();
+        ImageLevel level{std::max(1, source.width / 2), std::max(1, source.height / 2), {}};
+        level.data.resize(static_cast<size_t>(level.width) * level.height * channels);
+        for (int y = 0; y < level.height; y++) {
+            int y0 = std::min(2 * y, source.height - 1), y1 = std::min(2 * y + 1, source.height - 1);
+            for (int x = 0; x < level.width; x++) {
+                int x0 = std::min(2 * x, source.width - 1), x1 = std::min(2 * x + 1, source.width - 1);
+                for (int c = 0; c < channels; c++) {
+                    auto at = [&](int sx, int sy) {
+                        return source.data[(static_cast<size_t>(sy) * source.width + sx) * channels + c];
+                    };
+                    int sum = at(x0, y0) + at(x1, y0) + at(x0, y1) + at(x1, y1);
+                    level.data[(static_cast<size_t>(y) * level.width + x) * channels + c] =
+                            static_cast<unsigned char>((sum + 2) / 4);
+                }
+            }
+        }
+        levels.push_back(std::move(level));
+    }
+    MemoryStats::add(TEXTURE_STAGING, getBytes());
+}
 
-    glBindTexture(GL_TEXTURE_2D, 0);
-    stbi_image_free(data);
+MipmappedImage::MipmappedImage(GLenum format, GLenum internalFormat, std::vector<ImageLevel> &&levels)
+        : format(format), internalFormat(internalFormat), levels(std::move(levels)) {
+    MemoryStats::add(TEXTURE_STAGING, getBytes());
 }
 
-void Texture2D::bindTexture() {
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, getTexId());
+MipmappedImage::~MipmappedImage() {
+    if (!levels.empty())
+        MemoryStats::remove(TEXTURE_STAGING, getBytes());
 }
 
-void Texture2D::loadFromFaceFiles(const std::vector<std::string> &filePaths) {
+MipmappedImage::MipmappedImage(MipmappedImage &&other) noexcept {
+    *this = std::move(other);
+}
+
+MipmappedImage &MipmappedImage::operator=(MipmappedImage &&other) noexcept {
+    if (this != &other) {
+        std::swap(format, other.format);
+        std::swap(internalFormat, other.internalFormat);
+        std::swap(levels, other.levels);
+    }
+    return *this;
+}
+
+void MipmappedImage::setCompressedLevels(GLenum compressedFormat, std::vector<ImageLevel> &&compressedLevels) {
+    MemoryStats::remove(TEXTURE_STAGING, getBytes());
+    internalFormat = compressedFormat;
+    levels = std::move(compressedLevels);
+    MemoryStats::add(TEXTURE_STAGING, getBytes());
+}
+
+int64_t MipmappedImage::getBytes() const {
+    int64_t bytes = 0;
+    for (const ImageLevel &level : levels)
+        bytes += static_cast<int64_t>(level.data.size());
+    return bytes;
+}
+
+void MipmappedImage::upload(GLenum target) const {
+    for (size_t i = 0; i < levels.size(); i++) {
+        const ImageLevel &level = levels[i];
+        auto size = static_cast<GLsizeiptr>(level.data.size());
+        if (isCompressed()) {
+            TextureUploader::compressedTexImage2D(target, static_cast<GLint>(i), internalFormat, level.width,
+                                                  level.height, level.data.data(), size);
+        } else {
+            TextureUploader::texImage2D(target, static_cast<GLint>(i), format, level.width, level.height, format,
+                                        level.data.data(), size);
+        }
+    }
+}
+
+/** Sets the filtering of the currently bound texture: the mip levels are blended when minified, the pixels are kept
+ * sharp when magnified
+ */
+static void setFiltering(GLenum target, size_t levelCount) {
+    glTexParameteri(target, GL_TEXTURE_BASE_LEVEL, 0);
+    glTexParameteri(target, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(levelCount) - 1);
+    glTexParameteri(target, GL_TEXTURE_MIN_FILTER, levelCount > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+    glTexParameteri(target, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+}
+
+void Texture2D::loadFromFile(const std::string &filePath) {
+    upload(MipmappedImage(DecodedImage(filePath)));
+}
+
+void Texture2D::upload(const MipmappedImage &image) {
+    if (!image.isValid()) {
+        texID = 0;
+        return;
+    }
+
     GLuint tempId = 0;
     glGenTextures(1, &tempId);
     setTexId(tempId);
-    glBindTexture(GL_TEXTURE_2D, getTexId());
-    // set the texture wrapping parameters
+    GLStateCache::bindTexture(GL_TEXTURE0, GL_TEXTURE_2D, getTexId());
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
     // set texture filtering parameters
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-    // load image, create texture and generate mipmaps
-    int width, height, nrChannels;
-    unsigned char *data = stbi_load(filePaths[0].c_str(), &width, &height, &nrChannels, 0);
-    if (!data) {
-        std::cout << "Failed to load texture" << std::endl;
-        texID = 0;
-        return;
-    }
-    GLenum format = 0;
-    if (nrChannels == 1) {
-        format = GL_RED; //oof
-        // glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_G, GL_RED);
-        // glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_B, GL_RED);
-    } else if (nrChannels == 3)
-        format = GL_RGB;
-    else if (nrChannels == 4)
-        format = GL_RGBA;
+    setFiltering(GL_TEXTURE_2D, image.getLevels().size());
 
-    glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
+    image.upload(GL_TEXTURE_2D);
 
-    glBindTexture(GL_TEXTURE_2D, 0);
-    stbi_image_free(data);
+    GLStateCache::bindTexture(GL_TEXTURE0, GL_TEXTURE_2D, 0);
+    trackGpuBytes(image.getBytes());
+}
+
+void Texture2D::bindTexture() {
+    GLStateCache::bindTexture(GL_TEXTURE0, GL_TEXTURE_2D, getTexId());
+    RenderStats::count(TEXTURE_BINDS);
+}
 
+void Texture2D::loadFromFaceFiles(const std::vector<std::string> &filePaths) {
+    // a 2D texture only has the one face
+    upload(MipmappedImage(DecodedImage(filePaths[0])));
 }
 
 Texture2D::Texture2D(const std::string &filePath) {
     loadFromFile(filePath);
 }
 
+Texture2D::Texture2D(const MipmappedImage &image) {
+    upload(image);
+}
+
 CubeMap::CubeMap(const std::vector<std::string> &filePaths) {
     loadFromFaceFiles(filePaths);
 }
 
-void CubeMap::loadFromFile(const std::string &filePath) {
-    GLuint tempId = 0;
-    glGenTextures(1, &tempId);
-    setTexId(tempId);
-    glBindTexture(GL_TEXTURE_CUBE_MAP, getTexId());
-
-    // set the texture wrapping parameters
-    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
-
-    // set texture filtering parameters
-    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+CubeMap::CubeMap(const std::vector<MipmappedImage> &faces) {
+    upload(faces);
+}
 
-    // load image, create texture and generate mipmaps
-    int width, height, nrChannels;
-    unsigned char *data = stbi_load(filePath.c_str(), &width, &height, &nrChannels, 0);
-    if (!data) {
-        std::cout << "Failed to load texture " + filePath << std::endl;
-        texID = 0;
-        return;
-    }
+void CubeMap::loadFromFile(const std::string &filePath) {
+    std::vector<MipmappedImage> faces;
+    faces.emplace_back(DecodedImage(filePath));
+    upload(faces);
+}
 
+void CubeMap::loadFromFaceFiles(const std::vector<std::string> &filePaths) {
+    std::vector<MipmappedImage> faces;
     for (unsigned int i = 0; i < 6; i++) {
-        GLenum format = 0;
-        if (nrChannels == 1) {
-            format = GL_RED; //oof
-        } else if (nrChannels == 3)
-            format = GL_RGB;
-        else if (nrChannels == 4)
-            format = GL_RGBA;
-        glTexImage2D(
-                GL_TEXTURE_CUBE_MAP_POSITIVE_X + i,
-                0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
+        faces.emplace_back(DecodedImage(filePaths[i]));
     }
+    upload(faces);
+}
 
-    glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
-    stbi_image_free(data);
+void CubeMap::upload(const std::vector<MipmappedImage> &faces) {
+    std::vector<const MipmappedImage *> facePointers;
+    for (const MipmappedImage &face : faces)
+        facePointers.push_back(&face);
+    upload(facePointers);
 }
 
-void CubeMap::loadFromFaceFiles(const std::vector<std::string> &filePaths) {
+void CubeMap::upload(const std::vector<const MipmappedImage *> &faces) {
+    for (const MipmappedImage *face : faces) {
+        if (!face->isValid()) {
+            texID = 0;
+            return;
+        }
+    }
+
     GLuint tempId = 0;
     glGenTextures(1, &tempId);
     setTexId(tempId);
-    glBindTexture(GL_TEXTURE_CUBE_MAP, getTexId());
+    GLStateCache::bindTexture(GL_TEXTURE1, GL_TEXTURE_CUBE_MAP, getTexId());
 
     // set the texture wrapping parameters
     glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
     glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
     glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
 
-    // set texture filtering parameters
-    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-
-    // load image, create texture and generate mipmaps
-    int width, height, nrChannels;
-    unsigned char *data;
+    // set texture filtering parameters, the faces must all have the same number of levels
+    setFiltering(GL_TEXTURE_CUBE_MAP, faces[0]->getLevels().size());
 
+    int64_t textureBytes = 0;
     for (unsigned int i = 0; i < 6; i++) {
-        data = stbi_load(filePaths[i].c_str(), &width, &height, &nrChannels, 0);
-        if (!data) {
-            std::cout << "Failed to load texture " + filePaths[i] << std::endl;
-            texID = 0;
-            return;
-        }
-        GLenum format = 0;
-        if (nrChannels == 1) {
-            format = GL_RED; //oof
-        } else if (nrChannels == 3)
-            format = GL_RGB;
-        else if (nrChannels == 4)
-            format = GL_RGBA;
-        glTexImage2D(
-                GL_TEXTURE_CUBE_MAP_POSITIVE_X + i,
-                0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
+        // a single image is used for all six faces
+        const MipmappedImage &face = *(faces.size() == 1 ? faces[0] : faces[i]);
+        face.upload(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i);
+        textureBytes += face.getBytes();
     }
 
-    glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
-    stbi_image_free(data);
+    GLStateCache::bindTexture(GL_TEXTURE1, GL_TEXTURE_CUBE_MAP, 0);
+    trackGpuBytes(textureBytes);
 }
 
 void CubeMap::bindTexture() {
-    glActiveTexture(GL_TEXTURE1); // Cannot have different type of textures bound to same texture unit
-    glBindTexture(GL_TEXTURE_CUBE_MAP, getTexId());
-}
\ No newline at end of file
+    // Cannot have different type of textures bound to same texture unit
+    GLStateCache::bindTexture(GL_TEXTURE1, GL_TEXTURE_CUBE_MAP, getTexId());
+    RenderStats::count(TEXTURE_BINDS);
+}
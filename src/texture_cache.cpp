@@ -0,0 +1,146 @@
+//
+// Created on 10/19/2026.
+//
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include "../libs/easylogging++.h"
+#include "../include/texture_cache.h"
+#include "../include/cache_file.h"
+#include "../include/engine_constants.h"
+#include "../include/gl_state.h"
+#include "../include/texture_uploader.h"
+
+/// Bumped whenever the way textures are baked changes, so older entries are baked again
+static constexpr uint32_t TEXTURE_CACHE_VERSION = 1;
+static constexpr char TEXTURE_CACHE_MAGIC[4] = {'T', 'E', 'X', 'C'};
+
+/// Start of every cache entry, followed by each level: its width, height and size as uint32, then its data
+struct TextureCacheHeader {
+    char magic[4];
+    uint32_t version;
+    uint64_t sourceSize;   // to tell if the source image changed since the entry was baked
+    int64_t sourceTime;
+    uint32_t format;
+    uint32_t internalFormat;
+    uint32_t levelCount;
+};
+
+/// The entry of a source image (all of them live in resources/textures)
+static std::filesystem::path cachePath(const std::string &sourcePath) {
+    return CacheFile::getPath(EngineConstants::TEXTURE_CACHE_DIR, sourcePath, ".tex");
+}
+
+bool TextureCache::isCompressionSupported() {
+    return GLEW_EXT_texture_compression_s3tc;
+}
+
+bool TextureCache::load(const std::string &sourcePath, MipmappedImage &image) {
+    TextureCacheHeader source{};
+    if (!CacheFile::describeSource(sourcePath, source))
+        return false;
+
+    std::error_code error;
+    std::filesystem::path path = cachePath(sourcePath);
+    uintmax_t fileSize = std::filesystem::file_size(path, error);
+    std::ifstream file(path, std::ios::binary);
+    if (error || !file.is_open())
+        return false;
+
+    TextureCacheHeader header{};
+    file.read(reinterpret_cast<char *>(&header), sizeof(header));
+    if (!file || std::memcmp(header.magic, TEXTURE_CACHE_MAGIC, sizeof(header.magic)) != 0 ||
+        header.version != TEXTURE_CACHE_VERSION || header.sourceSize != source.sourceSize ||
+        header.sourceTime != source.sourceTime || header.levelCount == 0 || header.levelCount > 32)
+        return false;
+    if (header.internalFormat != header.format && !isCompressionSupported())
+        return false;
+
+    // the sizes come from the file, so a damaged entry is caught before they're allocated rather than after
+    uintmax_t remaining = fileSize >= sizeof(header) ? fileSize - sizeof(header) : 0;
+    std::vector<ImageLevel> levels(header.levelCount);
+    for (ImageLevel &level : levels) {
+        uint32_t description[3];
+        file.read(reinterpret_cast<char *>(description), sizeof(description));
+        if (!file || remaining < sizeof(description) + static_cast<uintmax_t>(description[2]))
+            return false;
+        remaining -= sizeof(description) + description[2];
+        level.width = static_cast<int>(description[0]);
+        level.height = static_cast<int>(description[1]);
+        level.data.resize(description[2]);
+        file.read(reinterpret_cast<char *>(level.data.data()), static_cast<std::streamsize>(level.data.size()));
+        if (!file)
+            return false;
+    }
+    if (remaining != 0)
+        return false;
+
+    image = MipmappedImage(header.format, header.internalFormat, std::move(levels));
+    return true;
+}
+
+bool TextureCache::store(const std::string &sourcePath, const MipmappedImage &image) {
+    TextureCacheHeader header{};
+    if (!image.isValid() || !CacheFile::describeSource(sourcePath, header))
+        return false;
+    std::memcpy(header.magic, TEXTURE_CACHE_MAGIC, sizeof(header.magic));
+    header.version = TEXTURE_CACHE_VERSION;
+    header.format = image.getFormat();
+    header.internalFormat = image.getInternalFormat();
+    header.levelCount = static_cast<uint32_t>(image.getLevels().size());
+
+    return CacheFile::write(cachePath(sourcePath), sourcePath, [&](std::ostream &file) {
+        file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        for (const ImageLevel &level : image.getLevels()) {
+            uint32_t description[3] = {static_cast<uint32_t>(level.width), static_cast<uint32_t>(level.height),
+                                       static_cast<uint32_t>(level.data.size())};
+            file.write(reinterpret_cast<const char *>(description), sizeof(description));
+            file.write(reinterpret_cast<const char *>(level.data.data()),
+                       static_cast<std::streamsize>(level.data.size()));
+        }
+    });
+}
+
+bool TextureCache::compress(MipmappedImage &image) {
+    if (!image.isValid() || image.isCompressed() || !isCompressionSupported())
+        return false;
+
+    // the driver encodes the levels when they're uploaded to a compressed texture, they're then read back
+    GLenum compressedFormat =
+            image.getFormat() == GL_RGBA ? GL_COMPRESSED_RGBA_S3TC_DXT5_EXT : GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+    GLuint texture = 0;
+    glGenTextures(1, &texture);
+    GLStateCache::bindTexture(GL_TEXTURE0, GL_TEXTURE_2D, texture);
+
+    const std::vector<ImageLevel> &levels = image.getLevels();
+    for (size_t i = 0; i < levels.size(); i++) {
+        TextureUploader::texImage2D(GL_TEXTURE_2D, static_cast<GLint>(i), compressedFormat, levels[i].width,
+                                    levels[i].height, image.getFormat(), levels[i].data.data(),
+                                    static_cast<GLsizeiptr>(levels[i].data.size()));
+    }
+
+    std::vector<ImageLevel> compressedLevels(levels.size());
+    bool compressed = true;
+    for (size_t i = 0; i < levels.size() && compressed; i++) {
+        auto level = static_cast<GLint>(i);
+        GLint isCompressed = GL_FALSE, size = 0;
+        glGetTexLevelParameteriv(GL_TEXTURE_2D, level, GL_TEXTURE_COMPRESSED, &isCompressed);
+        glGetTexLevelParameteriv(GL_TEXTURE_2D, level, GL_TEXTURE_COMPRESSED_IMAGE_SIZE, &size);
+        compressed = isCompressed == GL_TRUE && size > 0;
+        if (compressed) {
+            compressedLevels[i] = {levels[i].width, levels[i].height,
+                                   std::vector<unsigned char>(static_cast<size_t>(size))};
+            glGetCompressedTexImage(GL_TEXTURE_2D, level, compressedLevels[i].data.data());
+        }
+    }
+
+    GLStateCache::bindTexture(GL_TEXTURE0, GL_TEXTURE_2D, 0);
+    glDeleteTextures(1, &texture);
+    if (!compressed) {
+        LOG(WARNING) << "The driver did not compress a texture, it is cached uncompressed.";
+        return false;
+    }
+    image.setCompressedLevels(compressedFormat, std::move(compressedLevels));
+    return true;
+}
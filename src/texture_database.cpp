@@ -1,39 +1,286 @@
 //
 // Created by Willi on 8/2/2020.
 //
+#include <chrono>
 #include "../include/texture_database.h"
+#include "../include/engine_constants.h"
+#include "../include/logging.h"
+#include "../include/profiler.h"
+#include "../include/texture_cache.h"
+#include "../include/texture_uploader.h"
 
 TextureDatabase TextureDatabase::instance;
 
-TextureDatabase::TextureDatabase() {
-    this->textures = std::unordered_map<BlockID, std::shared_ptr<TextureInterface>>();
+/// The grey shown by textures that aren't loaded yet
+static constexpr unsigned char PLACEHOLDER_GREY = 128;
+
+/// The images of a block's texture: one for a 2D texture, six for a cube map
+static std::vector<std::string> getImagePaths(const BlockProperties &block) {
+    std::vector<std::string> paths;
+    if (block.textureType == TEXTURE2D)
+        paths.emplace_back(block.texture);
+    else if (block.textureType == CUBEMAP)
+        paths.insert(paths.end(), block.faces.begin(), block.faces.end());
+    return paths;
+}
+
+/// The images of some blocks' textures. An image is listed once, however many faces and blocks show it.
+struct TextureImages {
+    std::vector<std::string> paths;
+    std::vector<std::vector<size_t>> blockImages; // for each block, the index in paths of each of its images
+};
+
+static TextureImages collectImages(const std::vector<BlockID> &blocks) {
+    TextureImages images;
+    std::unordered_map<std::string, size_t> indices;
+    for (BlockID block : blocks) {
+        std::vector<size_t> &blockImages = images.blockImages.emplace_back();
+        for (const std::string &path : getImagePaths(BlockRegistry::get(block))) {
+            auto [it, inserted] = indices.try_emplace(path, images.paths.size());
+            if (inserted)
+                images.paths.push_back(path);
+            blockImages.push_back(it->second);
+        }
+    }
+    return images;
+}
+
+/// Uploads the images of a block's texture, indices into images as listed by TextureImages
+static void uploadTexture(TextureInterface &texture, const std::vector<MipmappedImage> &images,
+                          const std::vector<size_t> &indices) {
+    if (texture.getTextureType() == CUBEMAP) {
+        std::vector<const MipmappedImage *> faces;
+        for (size_t index : indices)
+            faces.push_back(&images[index]);
+        static_cast<CubeMap &>(texture).upload(faces);
+    } else {
+        static_cast<Texture2D &>(texture).upload(images[indices[0]]);
+    }
+}
+
+/// Reads an image from the texture cache, or decodes and mipmaps it. Returns true when it was decoded, to be baked.
+static bool loadImage(const std::string &path, MipmappedImage &image) {
+    if (TextureCache::load(path, image))
+        return false;
+    image = MipmappedImage(DecodedImage(path));
+    return image.isValid();
+}
+
+/// A single grey pixel
+static MipmappedImage makePlaceholderImage() {
+    std::vector<ImageLevel> levels(1);
+    levels[0] = {1, 1, std::vector<unsigned char>(3, PLACEHOLDER_GREY)};
+    return MipmappedImage(GL_RGB, GL_RGB, std::move(levels));
 }
 
-void TextureDatabase::init() {
+TextureDatabase::TextureDatabase() = default;
+
+void TextureDatabase::init(JobSystem &jobs, bool lazy) {
+    PROFILE_FUNCTION();
 
     LOG(INFO) << "Initializing Texture Database ...";
+    instance.jobs = &jobs;
+    instance.lazy = lazy;
+    if (lazy) {
+        instance.createPlaceholders();
+        LOG(INFO) << "Textures are loaded on first use, with a budget of "
+                  << EngineConstants::TEXTURE_RESIDENCY_BUDGET / (1024 * 1024) << " MiB.";
+        return;
+    }
+    instance.loadAll();
+}
+
+void TextureDatabase::loadAll() {
+    const std::vector<BlockID> &blocks = BlockRegistry::getDefinedBlocks();
 
-    for (const auto &file : fs::directory_iterator(fs::current_path().string() + "/resources/blocks/")) {
-        LOG(INFO) << "Processing " + file.path().filename().string() << " for textures.";
+    // every image is loaded on its own job, once even when several faces or blocks share it
+    TextureImages textureImages = collectImages(blocks);
+    const std::vector<std::string> &imagePaths = textureImages.paths;
 
-        // Inserts BlockId => Texture
-        BlockFileData texData = readBlockFile("./resources/blocks/" + file.path().filename().string());
-        if (texData.textureType == TEXTURE2D) {
-            instance.textures[texData.ID] = std::make_shared<Texture2D>(texData.textureFile);
-        } else if (texData.textureType == CUBEMAP) {
-            instance.textures[texData.ID] = std::make_shared<CubeMap>(texData.cubeFaceFiles);
+    // images come from the texture cache, those missing from it are decoded and mipmapped to be baked below
+    std::vector<MipmappedImage> images(imagePaths.size());
+    std::vector<char> baked(imagePaths.size(), false);
+    std::vector<double> loadMs(imagePaths.size());
+    auto imageCount = static_cast<unsigned int>(imagePaths.size());
+    auto loadStart = std::chrono::steady_clock::now();
+    jobs->wait(jobs->parallelFor(0, imageCount, 1, [&](unsigned int first, unsigned int last) {
+        for (unsigned int i = first; i < last; i++) {
+            PROFILE_SCOPE("Load image");
+            auto start = std::chrono::steady_clock::now();
+            baked[i] = loadImage(imagePaths[i], images[i]);
+            loadMs[i] = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
         }
+    }));
+    double loadWallMs = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - loadStart).count();
+
+    // the driver compresses the new images on this thread, then they're written to the cache on the workers
+    unsigned int bakedCount = 0, compressedCount = 0;
+    for (size_t i = 0; i < images.size(); i++) {
+        if (!baked[i])
+            continue;
+        bakedCount++;
+        if (TextureCache::compress(images[i]))
+            compressedCount++;
+    }
+    if (bakedCount > 0) {
+        jobs->wait(jobs->parallelFor(0, imageCount, 1, [&](unsigned int first, unsigned int last) {
+            for (unsigned int i = first; i < last; i++) {
+                if (baked[i])
+                    TextureCache::store(imagePaths[i], images[i]);
+            }
+        }));
+        LOG(INFO) << "Baked " << bakedCount << " textures into " << EngineConstants::TEXTURE_CACHE_DIR << " ("
+                  << compressedCount << " compressed).";
+    }
+
+    // Inserts BlockId => Texture, all the uploads in one go on the GL thread
+    auto uploadStart = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < blocks.size(); i++) {
+        TextureType type = BlockRegistry::get(blocks[i]).textureType;
+        if (type == TEXTURE2D)
+            textures[blocks[i]] = std::make_shared<Texture2D>();
+        else if (type == CUBEMAP)
+            textures[blocks[i]] = std::make_shared<CubeMap>();
+        if (textures[blocks[i]])
+            uploadTexture(*textures[blocks[i]], images, textureImages.blockImages[i]);
+    }
+    TextureUploader::flush();
+    double uploadMs = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - uploadStart).count();
+
+    // what loading would have taken on a single thread, to compare with the parallel time
+    double serialLoadMs = 0.0;
+    for (double ms : loadMs)
+        serialLoadMs += ms;
+    LOG(INFO) << "Loaded " << imageCount << " images (" << imageCount - bakedCount << " from the cache) in "
+              << loadWallMs << " ms on " << jobs->getWorkerCount() + 1 << " threads (" << serialLoadMs
+              << " ms on a single thread, " << (loadWallMs > 0.0 ? serialLoadMs / loadWallMs : 1.0)
+              << "x), uploaded them in " << uploadMs << " ms.";
+    TextureUploaderStats uploadStats = TextureUploader::getStats();
+    LOG(INFO) << uploadStats.streamedUploads << " uploads streamed through the pixel buffer ring ("
+              << uploadStats.streamedBytes / 1024 << " KiB), " << uploadStats.directUploads << " direct, "
+              << uploadStats.stalls << " stalls.";
+}
 
-        LOG(INFO) << "Finished processing " + file.path().filename().string() + ".";
+void TextureDatabase::createPlaceholders() {
+    placeholder2D = std::make_shared<Texture2D>(makePlaceholderImage());
+    std::vector<MipmappedImage> faces;
+    faces.push_back(makePlaceholderImage());
+    placeholderCubeMap = std::make_shared<CubeMap>(faces);
+
+    // the texture objects exist from the start, so that they can be handed out before they're loaded
+    for (unsigned int id = 0; id < BLOCK_ID_COUNT; id++) {
+        residency.add();
+        TextureType type = BlockRegistry::get(static_cast<BlockID>(id)).textureType;
+        if (type == TEXTURE2D)
+            textures[id] = std::make_shared<Texture2D>();
+        else if (type == CUBEMAP)
+            textures[id] = std::make_shared<CubeMap>();
+        if (textures[id])
+            textures[id]->setTexId(getPlaceholderId(static_cast<BlockID>(id)));
     }
 }
 
-std::shared_ptr <TextureInterface> &TextureDatabase::getTextureByBlockId(BlockID id) {
+GLuint TextureDatabase::getPlaceholderId(BlockID id) const {
+    return textures[id]->getTextureType() == CUBEMAP ? placeholderCubeMap->getTexId() : placeholder2D->getTexId();
+}
+
+/// The images of a texture loading in the background
+struct PendingTexture {
+    TextureImages textureImages;
+    std::vector<MipmappedImage> images;
+    std::vector<char> baked;
+};
+
+void TextureDatabase::requestLoad(BlockID id) {
+    auto pending = std::make_shared<PendingTexture>();
+    pending->textureImages = collectImages({id});
+    pending->images.resize(pending->textureImages.paths.size());
+    pending->baked.resize(pending->textureImages.paths.size(), false);
+
+    auto imageCount = static_cast<unsigned int>(pending->images.size());
+    JobHandle load = jobs->parallelFor(0, imageCount, 1, [pending](unsigned int first, unsigned int last) {
+        for (unsigned int i = first; i < last; i++) {
+            PROFILE_SCOPE("Load image");
+            pending->baked[i] = loadImage(pending->textureImages.paths[i], pending->images[i]);
+        }
+    });
+
+    // compressing and uploading need the context
+    jobs->then(load, [id, pending]() {
+        PROFILE_SCOPE("Upload texture");
+        for (const MipmappedImage &image : pending->images) {
+            if (!image.isValid()) {
+                LOG(WARNING) << "Could not load the texture of " << id << ", keeping the placeholder.";
+                instance.residency.failed(id);
+                return;
+            }
+        }
+
+        bool anyBaked = false;
+        for (size_t i = 0; i < pending->images.size(); i++) {
+            if (pending->baked[i]) {
+                TextureCache::compress(pending->images[i]);
+                anyBaked = true;
+            }
+        }
+
+        TextureInterface &texture = *instance.textures[id];
+        uploadTexture(texture, pending->images, pending->textureImages.blockImages[0]);
+        instance.residency.loaded(id, texture.getGpuBytes());
+        ENGINE_LOG(DEBUG) << "Loaded the texture of " << id << " (" << texture.getGpuBytes() / 1024 << " KiB).";
+
+        // the baked images are written to the cache in the background, the job keeps them alive until then
+        if (anyBaked) {
+            instance.jobs->submit([pending]() {
+                for (size_t i = 0; i < pending->images.size(); i++) {
+                    if (pending->baked[i])
+                        TextureCache::store(pending->textureImages.paths[i], pending->images[i]);
+                }
+            });
+        }
+    }, MAIN_THREAD);
+}
+
+std::shared_ptr<TextureInterface> &TextureDatabase::getTextureByBlockId(BlockID id) {
+    if (instance.lazy && instance.textures[id] && instance.residency.use(id))
+        instance.requestLoad(id);
     return instance.textures[id];
 }
 
-TextureDatabase::~TextureDatabase() {
-    for (auto &pair : textures) {
-        pair.second->destroyTexture();
+void TextureDatabase::update() {
+    if (!instance.lazy)
+        return;
+    for (size_t id : instance.residency.nextFrame()) {
+        TextureInterface &texture = *instance.textures[id];
+        ENGINE_LOG(DEBUG) << "Evicted the texture of " << static_cast<BlockID>(id) << " ("
+                          << texture.getGpuBytes() / 1024 << " KiB).";
+        texture.destroyTexture();
+        texture.setTexId(instance.getPlaceholderId(static_cast<BlockID>(id)));
+    }
+}
+
+AssetResidencyStats TextureDatabase::getResidencyStats() {
+    return instance.residency.getStats();
+}
+
+void TextureDatabase::destroy() {
+    for (unsigned int id = 0; id < BLOCK_ID_COUNT; id++) {
+        // while not resident, a lazy texture only points to a placeholder
+        if (instance.textures[id] && (!instance.lazy || instance.residency.getState(id) == ASSET_RESIDENT))
+            instance.textures[id]->destroyTexture();
+        instance.textures[id].reset();
     }
+    if (instance.placeholder2D)
+        instance.placeholder2D->destroyTexture();
+    if (instance.placeholderCubeMap)
+        instance.placeholderCubeMap->destroyTexture();
+    instance.placeholder2D.reset();
+    instance.placeholderCubeMap.reset();
+}
+
+TextureDatabase::~TextureDatabase() {
+    // the GL objects are gone with the context by now, unless destroy() wasn't called
+    destroy();
 }
@@ -0,0 +1,137 @@
+//
+// Created on 10/19/2026.
+//
+#include <cstring>
+#include "../libs/easylogging++.h"
+#include "../include/texture_uploader.h"
+
+TextureUploader TextureUploader::instance;
+
+/// Offsets in the ring are kept aligned to this, which covers every unpack alignment
+static constexpr GLsizeiptr UPLOAD_ALIGNMENT = 16;
+
+/// How long to wait on a fence before checking again, in nanoseconds
+static constexpr GLuint64 FENCE_TIMEOUT = 1000000000;
+
+void TextureUploader::init() {
+    initialized = true;
+    // mip levels are tightly packed, their rows aren't aligned to 4 bytes
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    if (!GLEW_VERSION_4_4 && !GLEW_ARB_buffer_storage) {
+        LOG(INFO) << "ARB_buffer_storage is not supported, textures are uploaded from client memory.";
+        return;
+    }
+
+    GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    glGenBuffers(1, &buffer);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, buffer);
+    glBufferStorage(GL_PIXEL_UNPACK_BUFFER, SEGMENT_SIZE * SEGMENT_COUNT, nullptr, flags);
+    mapped = static_cast<unsigned char *>(glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, SEGMENT_SIZE * SEGMENT_COUNT,
+                                                           flags));
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+    if (mapped == nullptr) {
+        LOG(WARNING) << "Could not map the texture upload ring, textures are uploaded from client memory.";
+        glDeleteBuffers(1, &buffer);
+        buffer = 0;
+        return;
+    }
+    persistent = true;
+    LOG(INFO) << "Streaming texture uploads through " << SEGMENT_COUNT << " pixel buffer segments of "
+              << SEGMENT_SIZE / 1024 << " KiB.";
+}
+
+void TextureUploader::nextSegment() {
+    fences[segment] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    segment = (segment + 1) % SEGMENT_COUNT;
+    offset = 0;
+
+    GLsync fence = fences[segment];
+    if (fence == nullptr)
+        return;
+    GLenum result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+    if (result == GL_TIMEOUT_EXPIRED) {
+        stats.stalls++;
+        while (result == GL_TIMEOUT_EXPIRED)
+            result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, FENCE_TIMEOUT);
+    }
+    glDeleteSync(fence);
+    fences[segment] = nullptr;
+}
+
+bool TextureUploader::stage(const void *data, GLsizeiptr size, GLintptr &start) {
+    if (!initialized)
+        init();
+
+    if (!persistent || size > SEGMENT_SIZE) {
+        stats.directUploads++;
+        return false;
+    }
+
+    if (offset + size > SEGMENT_SIZE)
+        nextSegment();
+
+    start = static_cast<GLintptr>(segment) * SEGMENT_SIZE + offset;
+    std::memcpy(mapped + start, data, static_cast<size_t>(size));
+
+    // the ring is coherent, so the copy is visible to the GL without a flush
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, buffer);
+
+    offset += (size + UPLOAD_ALIGNMENT - 1) / UPLOAD_ALIGNMENT * UPLOAD_ALIGNMENT;
+    stats.streamedUploads++;
+    stats.streamedBytes += static_cast<unsigned long long>(size);
+    return true;
+}
+
+void TextureUploader::texImage2D(GLenum target, GLint level, GLenum internalFormat, GLsizei width, GLsizei height,
+                                 GLenum format, const void *pixels, GLsizeiptr size) {
+    auto internal = static_cast<GLint>(internalFormat);
+    GLintptr start = 0;
+    if (!instance.stage(pixels, size, start)) {
+        glTexImage2D(target, level, internal, width, height, 0, format, GL_UNSIGNED_BYTE, pixels);
+        return;
+    }
+    glTexImage2D(target, level, internal, width, height, 0, format, GL_UNSIGNED_BYTE,
+                 reinterpret_cast<const void *>(start));
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+}
+
+void TextureUploader::compressedTexImage2D(GLenum target, GLint level, GLenum internalFormat, GLsizei width,
+                                           GLsizei height, const void *data, GLsizeiptr size) {
+    GLintptr start = 0;
+    if (!instance.stage(data, size, start)) {
+        glCompressedTexImage2D(target, level, internalFormat, width, height, 0, static_cast<GLsizei>(size), data);
+        return;
+    }
+    glCompressedTexImage2D(target, level, internalFormat, width, height, 0, static_cast<GLsizei>(size),
+                           reinterpret_cast<const void *>(start));
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+}
+
+void TextureUploader::flush() {
+    if (instance.persistent && instance.offset > 0)
+        instance.nextSegment();
+}
+
+void TextureUploader::destroy() {
+    if (!instance.persistent)
+        return;
+    for (GLsync &fence : instance.fences) {
+        if (fence != nullptr)
+            glDeleteSync(fence);
+        fence = nullptr;
+    }
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, instance.buffer);
+    glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    glDeleteBuffers(1, &instance.buffer);
+    instance.buffer = 0;
+    instance.mapped = nullptr;
+    instance.persistent = false;
+    instance.initialized = false;
+    instance.offset = 0;
+}
+
+TextureUploaderStats TextureUploader::getStats() {
+    return instance.stats;
+}
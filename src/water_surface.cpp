@@ -0,0 +1,69 @@
+//
+// Created on 10/19/2026.
+//
+#include <algorithm>
+#include "../include/water_surface.h"
+#include "../include/cube_geometry.h"
+
+void WaterSurface::build(const std::vector<glm::vec3> &exposedBlocks, std::vector<ChunkVertex> &vertices,
+                         std::vector<unsigned int> &indices) {
+
+    const CubeFace &top = CubeGeometry::FACES[CubeGeometry::POS_Y];
+
+    firstVertex = static_cast<unsigned int>(vertices.size());
+    faceCenters.clear();
+    faceCenters.reserve(exposedBlocks.size());
+    vertices.reserve(vertices.size() + exposedBlocks.size() * 4);
+
+    for (const auto &block : exposedBlocks) {
+        for (unsigned int corner = 0; corner < 4; corner++) {
+            ChunkVertex vertex{};
+            vertex.position = block + glm::vec3(top.corners[corner].x, SURFACE_HEIGHT, top.corners[corner].z);
+            vertex.normal = top.normal;
+            vertex.textureCoordinate = top.textureCoordinates[corner];
+            vertex.localPosition = top.corners[corner];
+            vertices.push_back(vertex);
+        }
+        faceCenters.push_back(block + glm::vec3(0.5f, SURFACE_HEIGHT, 0.5f));
+    }
+
+    faceOrder.resize(faceCenters.size());
+    for (unsigned int i = 0; i < faceOrder.size(); i++)
+        faceOrder[i] = i;
+
+    sorted = false;
+    writeIndices(indices);
+}
+
+void WaterSurface::writeIndices(std::vector<unsigned int> &indices) const {
+    for (unsigned int face : faceOrder) {
+        for (unsigned int index : CubeGeometry::FACE_INDICES)
+            indices.push_back(firstVertex + face * 4 + index);
+    }
+}
+
+bool WaterSurface::needsResort(const glm::vec3 &viewPos) const {
+    if (!sorted)
+        return true;
+    glm::vec3 moved = viewPos - lastSortPosition;
+    return glm::dot(moved, moved) > RESORT_DISTANCE * RESORT_DISTANCE;
+}
+
+void WaterSurface::sortBackToFront(const glm::vec3 &viewPos, std::vector<unsigned int> &indices) {
+
+    lastSortPosition = viewPos;
+    sorted = true;
+
+    std::vector<float> distances(faceCenters.size());
+    for (unsigned int i = 0; i < faceCenters.size(); i++) {
+        glm::vec3 offset = faceCenters[i] - viewPos;
+        distances[i] = glm::dot(offset, offset);
+    }
+
+    // the previous order is usually nearly sorted already
+    std::stable_sort(faceOrder.begin(), faceOrder.end(),
+                     [&distances](unsigned int a, unsigned int b) { return distances[a] > distances[b]; });
+
+    indices.clear();
+    writeIndices(indices);
+}
@@ -0,0 +1,158 @@
+//
+// Created on 10/19/2026.
+//
+#include <vector>
+#include "../include/asset_residency.h"
+#include "test_harness.h"
+
+/// Uses an asset and marks it as loaded with the given size, as a database does once the load it asked for is done
+static void load(AssetResidency &residency, size_t index, int64_t bytes) {
+    residency.use(index);
+    residency.loaded(index, bytes);
+}
+
+TEST(residency, useAsksForALoadOnlyWhenUnloaded) {
+    AssetResidency residency(100);
+    size_t asset = residency.add();
+    size_t broken = residency.add();
+
+    EXPECT(residency.use(asset));
+    EXPECT_EQUAL(residency.getState(asset), ASSET_LOADING);
+    EXPECT(!residency.use(asset));
+    residency.loaded(asset, 10);
+    EXPECT(!residency.use(asset));
+    EXPECT_EQUAL(residency.getState(asset), ASSET_RESIDENT);
+
+    EXPECT(residency.use(broken));
+    residency.failed(broken);
+    EXPECT(!residency.use(broken));
+    EXPECT_EQUAL(residency.getState(broken), ASSET_FAILED);
+}
+
+TEST(residency, nothingIsEvictedWithinTheBudget) {
+    AssetResidency residency(100);
+    load(residency, residency.add(), 60);
+    load(residency, residency.add(), 40);
+    residency.nextFrame();
+    EXPECT(residency.nextFrame().empty());
+
+    AssetResidency unlimited;
+    load(unlimited, unlimited.add(), 1000000);
+    unlimited.nextFrame();
+    EXPECT(unlimited.nextFrame().empty());
+}
+
+TEST(residency, leastRecentlyUsedIsEvictedFirst) {
+    AssetResidency residency(100);
+    size_t first = residency.add();
+    size_t second = residency.add();
+    size_t third = residency.add();
+    load(residency, first, 50);
+    residency.nextFrame();
+    load(residency, second, 50);
+    residency.nextFrame();
+    load(residency, third, 50);
+
+    std::vector<size_t> evicted = residency.nextFrame();
+    EXPECT_EQUAL(evicted.size(), 1u);
+    EXPECT(!evicted.empty() && evicted[0] == first);
+    EXPECT_EQUAL(residency.getState(first), ASSET_UNLOADED);
+    EXPECT_EQUAL(residency.getState(second), ASSET_RESIDENT);
+
+    AssetResidencyStats stats = residency.getStats();
+    EXPECT_EQUAL(stats.loads, 3ull);
+    EXPECT_EQUAL(stats.evictions, 1ull);
+    EXPECT_EQUAL(stats.residentCount, 2u);
+    EXPECT_EQUAL(stats.residentBytes, 100);
+
+    // an evicted asset is loaded again the next time it's used
+    EXPECT(residency.use(first));
+}
+
+TEST(residency, pinnedAssetsAreKept) {
+    AssetResidency residency(100);
+    size_t pinned = residency.add(true);
+    size_t other = residency.add();
+    size_t recent = residency.add();
+    load(residency, pinned, 50);
+    residency.nextFrame();
+    load(residency, other, 50);
+    residency.nextFrame();
+    load(residency, recent, 50);
+
+    std::vector<size_t> evicted = residency.nextFrame();
+    EXPECT_EQUAL(evicted.size(), 1u);
+    EXPECT(!evicted.empty() && evicted[0] == other);
+    EXPECT_EQUAL(residency.getState(pinned), ASSET_RESIDENT);
+}
+
+TEST(residency, assetsUsedThisFrameAreKept) {
+    AssetResidency residency(100);
+    size_t first = residency.add();
+    size_t second = residency.add();
+    load(residency, first, 60);
+    load(residency, second, 60);
+
+    // both were used during the frame that ends, so the budget stays exceeded for now
+    EXPECT(residency.nextFrame().empty());
+    EXPECT_EQUAL(residency.getStats().residentBytes, 120);
+
+    // once neither is used, the oldest goes; they're tied, so the first one
+    std::vector<size_t> evicted = residency.nextFrame();
+    EXPECT_EQUAL(evicted.size(), 1u);
+    EXPECT(!evicted.empty() && evicted[0] == first);
+}
+
+TEST(residency, canEvictIsHonoured) {
+    AssetResidency residency(100);
+    size_t playing = residency.add();
+    size_t other = residency.add();
+    auto notPlaying = [playing](size_t index) { return index != playing; };
+    load(residency, playing, 60);
+    residency.nextFrame(notPlaying);
+    load(residency, other, 60);
+
+    // the oldest asset can't be evicted and the other one was just used
+    EXPECT(residency.nextFrame(notPlaying).empty());
+
+    // the next oldest is picked instead
+    std::vector<size_t> evicted = residency.nextFrame(notPlaying);
+    EXPECT_EQUAL(evicted.size(), 1u);
+    EXPECT(!evicted.empty() && evicted[0] == other);
+    EXPECT_EQUAL(residency.getState(playing), ASSET_RESIDENT);
+}
+
+TEST(residency, stopsWhenNothingCanBeEvicted) {
+    AssetResidency residency(100);
+    size_t pinned = residency.add(true);
+    size_t kept = residency.add();
+    load(residency, pinned, 80);
+    load(residency, kept, 80);
+    residency.nextFrame();
+
+    std::vector<size_t> evicted = residency.nextFrame([](size_t) { return false; });
+    EXPECT(evicted.empty());
+    EXPECT_EQUAL(residency.getStats().residentBytes, 160);
+    EXPECT_EQUAL(residency.getStats().evictions, 0ull);
+}
+
+TEST(residency, loadingAssetsAreNeverPicked) {
+    AssetResidency residency(100);
+    size_t loading = residency.add();
+    size_t resident = residency.add();
+    residency.use(loading);
+    load(residency, resident, 150);
+    residency.nextFrame();
+
+    // the loading asset was last used as long ago as the resident one, but it isn't even offered to canEvict
+    std::vector<size_t> offered;
+    std::vector<size_t> evicted = residency.nextFrame([&offered](size_t index) {
+        offered.push_back(index);
+        return true;
+    });
+    for (size_t index : offered)
+        EXPECT(index != loading);
+    EXPECT_EQUAL(evicted.size(), 1u);
+    EXPECT(!evicted.empty() && evicted[0] == resident);
+    EXPECT_EQUAL(residency.getState(loading), ASSET_LOADING);
+}
@@ -0,0 +1,170 @@
+//
+// Created on 10/19/2026.
+//
+#include <GL/glew.h>
+#include <GLFW/glfw3.h>
+#include "../include/gl_state.h"
+#include "test_harness.h"
+
+/// Creates the hidden window of a headless run once, like Engine::createHeadlessContext. False if there is no display.
+static bool makeContextCurrent() {
+    static GLFWwindow *window = nullptr;
+    static bool tried = false;
+    if (!tried) {
+        tried = true;
+        if (glfwInit()) {
+            glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+            window = glfwCreateWindow(64, 64, "gl-state-tests", nullptr, nullptr);
+        }
+        if (window) {
+            glfwMakeContextCurrent(window);
+            if (glewInit() != GLEW_OK)
+                window = nullptr;
+        }
+    }
+    if (!window)
+        testSkipped = true;
+    return window != nullptr;
+}
+
+/// Starts a case from a known state: nothing shadowed and the counters at zero
+static void resetCache() {
+    GLStateCache::invalidate();
+    GLStateCache::beginFrame();
+}
+
+TEST(gl, redundantChangesAreFiltered) {
+    if (!makeContextCurrent())
+        return;
+    resetCache();
+
+    GLuint vao = 0, textures[2] = {};
+    glGenVertexArrays(1, &vao);
+    glGenTextures(2, textures);
+
+    GLStateCache::useProgram(0);
+    GLStateCache::useProgram(0);
+    GLStateCache::useProgram(0);
+
+    GLStateCache::bindVertexArray(vao);
+    GLStateCache::bindVertexArray(vao);
+    GLStateCache::bindVertexArray(0);
+
+    // the second bind is filtered whole, the active unit isn't touched either
+    GLStateCache::bindTexture(GL_TEXTURE0, GL_TEXTURE_2D, textures[0]);
+    GLStateCache::bindTexture(GL_TEXTURE0, GL_TEXTURE_2D, textures[0]);
+    GLStateCache::bindTexture(GL_TEXTURE1, GL_TEXTURE_CUBE_MAP, textures[1]);
+
+    GLStateCache::depthFunc(GL_LEQUAL);
+    GLStateCache::depthFunc(GL_LEQUAL);
+
+    GLStateCache::depthMask(true);
+    GLStateCache::depthMask(true);
+
+    GLStateCache::setCapability(GL_BLEND, true);
+    GLStateCache::setCapability(GL_BLEND, true);
+    GLStateCache::setCapability(GL_BLEND, false);
+
+    const GLStateCounters &counters = GLStateCache::getCurrentCounters();
+    EXPECT_EQUAL(counters.issued[PROGRAM_BIND], 1u);
+    EXPECT_EQUAL(counters.filtered[PROGRAM_BIND], 2u);
+    EXPECT_EQUAL(counters.issued[VERTEX_ARRAY_BIND], 2u);
+    EXPECT_EQUAL(counters.filtered[VERTEX_ARRAY_BIND], 1u);
+    EXPECT_EQUAL(counters.issued[ACTIVE_TEXTURE], 2u);
+    EXPECT_EQUAL(counters.filtered[ACTIVE_TEXTURE], 0u);
+    EXPECT_EQUAL(counters.issued[TEXTURE_BIND], 2u);
+    EXPECT_EQUAL(counters.filtered[TEXTURE_BIND], 1u);
+    EXPECT_EQUAL(counters.issued[DEPTH_FUNC], 1u);
+    EXPECT_EQUAL(counters.filtered[DEPTH_FUNC], 1u);
+    EXPECT_EQUAL(counters.issued[DEPTH_MASK], 1u);
+    EXPECT_EQUAL(counters.filtered[DEPTH_MASK], 1u);
+    EXPECT_EQUAL(counters.issued[CAPABILITY], 2u);
+    EXPECT_EQUAL(counters.filtered[CAPABILITY], 1u);
+    EXPECT_EQUAL(counters.totalIssued(), 11u);
+    EXPECT_EQUAL(counters.totalFiltered(), 7u);
+
+    // the driver ends up in the state the cache believes in
+    GLint value = 0;
+    glGetIntegerv(GL_DEPTH_FUNC, &value);
+    EXPECT_EQUAL(value, GL_LEQUAL);
+    EXPECT(!glIsEnabled(GL_BLEND));
+    glGetIntegerv(GL_ACTIVE_TEXTURE, &value);
+    EXPECT_EQUAL(value, GL_TEXTURE1);
+    glGetIntegerv(GL_TEXTURE_BINDING_CUBE_MAP, &value);
+    EXPECT_EQUAL(static_cast<GLuint>(value), textures[1]);
+
+    // beginFrame hands the counters over to the last frame
+    GLStateCache::beginFrame();
+    EXPECT_EQUAL(GLStateCache::getFrameCounters().totalIssued(), 11u);
+    EXPECT_EQUAL(GLStateCache::getCurrentCounters().totalIssued(), 0u);
+
+    GLStateCache::bindVertexArray(0);
+    glDeleteVertexArrays(1, &vao);
+    GLStateCache::forgetVertexArray(vao);
+    glDeleteTextures(2, textures);
+    GLStateCache::forgetTexture(textures[0]);
+    GLStateCache::forgetTexture(textures[1]);
+}
+
+TEST(gl, deletedTextureNameIsBoundAgain) {
+    if (!makeContextCurrent())
+        return;
+    resetCache();
+
+    GLuint texture = 0;
+    glGenTextures(1, &texture);
+    GLStateCache::bindTexture(GL_TEXTURE0, GL_TEXTURE_2D, texture);
+    glDeleteTextures(1, &texture);
+    GLStateCache::forgetTexture(texture);
+
+    // GL reverted the unit to texture 0, the cache must know it
+    unsigned int filteredBefore = GLStateCache::getCurrentCounters().filtered[TEXTURE_BIND];
+    GLStateCache::bindTexture(GL_TEXTURE0, GL_TEXTURE_2D, 0);
+    EXPECT_EQUAL(GLStateCache::getCurrentCounters().filtered[TEXTURE_BIND], filteredBefore + 1);
+
+    // drivers may hand the freed name out again, which the cache must not take as still bound
+    GLuint regenerated = 0;
+    glGenTextures(1, &regenerated);
+    unsigned int issuedBefore = GLStateCache::getCurrentCounters().issued[TEXTURE_BIND];
+    GLStateCache::bindTexture(GL_TEXTURE0, GL_TEXTURE_2D, regenerated);
+    EXPECT_EQUAL(GLStateCache::getCurrentCounters().issued[TEXTURE_BIND], issuedBefore + 1);
+
+    GLint bound = 0;
+    glActiveTexture(GL_TEXTURE0);
+    glGetIntegerv(GL_TEXTURE_BINDING_2D, &bound);
+    EXPECT_EQUAL(static_cast<GLuint>(bound), regenerated);
+
+    GLStateCache::bindTexture(GL_TEXTURE0, GL_TEXTURE_2D, 0);
+    glDeleteTextures(1, &regenerated);
+    GLStateCache::forgetTexture(regenerated);
+}
+
+TEST(gl, deletedVertexArrayNameIsBoundAgain) {
+    if (!makeContextCurrent())
+        return;
+    resetCache();
+
+    GLuint vao = 0;
+    glGenVertexArrays(1, &vao);
+    GLStateCache::bindVertexArray(vao);
+    glDeleteVertexArrays(1, &vao);
+    GLStateCache::forgetVertexArray(vao);
+
+    unsigned int filteredBefore = GLStateCache::getCurrentCounters().filtered[VERTEX_ARRAY_BIND];
+    GLStateCache::bindVertexArray(0);
+    EXPECT_EQUAL(GLStateCache::getCurrentCounters().filtered[VERTEX_ARRAY_BIND], filteredBefore + 1);
+
+    GLuint regenerated = 0;
+    glGenVertexArrays(1, &regenerated);
+    unsigned int issuedBefore = GLStateCache::getCurrentCounters().issued[VERTEX_ARRAY_BIND];
+    GLStateCache::bindVertexArray(regenerated);
+    EXPECT_EQUAL(GLStateCache::getCurrentCounters().issued[VERTEX_ARRAY_BIND], issuedBefore + 1);
+
+    GLint bound = 0;
+    glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &bound);
+    EXPECT_EQUAL(static_cast<GLuint>(bound), regenerated);
+
+    GLStateCache::bindVertexArray(0);
+    glDeleteVertexArrays(1, &regenerated);
+    GLStateCache::forgetVertexArray(regenerated);
+}
@@ -0,0 +1,166 @@
+//
+// Created on 10/19/2026.
+//
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include "../include/job_system.h"
+#include "test_harness.h"
+
+/// Spins until the job is done or a second went by, without helping with the work like JobSystem::wait does
+static bool waitWithoutHelping(const JobHandle &job) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+    while (!job.isDone() && std::chrono::steady_clock::now() < deadline)
+        std::this_thread::yield();
+    return job.isDone();
+}
+
+TEST(jobs, dependenciesRunFirst) {
+    JobSystem jobs(4);
+    std::atomic<int> finishedDependencies{0};
+    std::atomic<int> seenByDependent{-1};
+
+    std::vector<JobHandle> dependencies;
+    for (int i = 0; i < 8; i++) {
+        dependencies.push_back(jobs.submit([&finishedDependencies]() {
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            finishedDependencies++;
+        }));
+    }
+    JobHandle dependent = jobs.submit([&]() { seenByDependent = finishedDependencies.load(); }, dependencies);
+    jobs.wait(dependent);
+
+    EXPECT_EQUAL(seenByDependent.load(), 8);
+    for (const JobHandle &dependency : dependencies)
+        EXPECT(dependency.isDone());
+}
+
+TEST(jobs, doneDependencyDoesNotBlock) {
+    JobSystem jobs(2);
+    JobHandle first = jobs.submit([]() {});
+    jobs.wait(first);
+
+    std::atomic<bool> ran{false};
+    jobs.wait(jobs.submit([&ran]() { ran = true; }, {first, JobHandle()}));
+    EXPECT(ran.load());
+}
+
+TEST(jobs, continuationsRunInOrder) {
+    JobSystem jobs(4);
+    std::mutex orderMutex;
+    std::vector<int> order;
+    auto record = [&](int step) {
+        std::lock_guard<std::mutex> lock(orderMutex);
+        order.push_back(step);
+    };
+
+    JobHandle last = jobs.submit([&]() { record(0); });
+    for (int step = 1; step < 16; step++)
+        last = jobs.then(last, [&record, step]() { record(step); });
+    jobs.wait(last);
+
+    EXPECT_EQUAL(order.size(), 16u);
+    for (size_t i = 0; i < order.size(); i++)
+        EXPECT_EQUAL(order[i], static_cast<int>(i));
+}
+
+TEST(jobs, mainThreadJobsOnlyRunInRunMainThreadJobs) {
+    JobSystem jobs(2);
+    std::atomic<bool> ran{false};
+    std::thread::id ranOn;
+
+    JobHandle work = jobs.submit([]() { std::this_thread::sleep_for(std::chrono::milliseconds(5)); });
+    JobHandle upload = jobs.then(work, [&]() {
+        ranOn = std::this_thread::get_id();
+        ran = true;
+    }, MAIN_THREAD);
+
+    // the workers are idle once the dependency is done, but none of them may pick the continuation up
+    EXPECT(waitWithoutHelping(work));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT(!ran.load());
+    EXPECT(!upload.isDone());
+
+    EXPECT_EQUAL(jobs.runMainThreadJobs(), 1u);
+    EXPECT(ran.load());
+    EXPECT(upload.isDone());
+    EXPECT(ranOn == std::this_thread::get_id());
+    EXPECT_EQUAL(jobs.getStats().mainThreadExecuted, 1ull);
+}
+
+TEST(jobs, runMainThreadJobsHonoursMaxJobs) {
+    JobSystem jobs(1);
+    std::atomic<int> ran{0};
+    for (int i = 0; i < 5; i++)
+        jobs.submit([&ran]() { ran++; }, {}, MAIN_THREAD);
+
+    EXPECT_EQUAL(jobs.runMainThreadJobs(2), 2u);
+    EXPECT_EQUAL(ran.load(), 2);
+    EXPECT_EQUAL(jobs.runMainThreadJobs(), 3u);
+    EXPECT_EQUAL(ran.load(), 5);
+}
+
+TEST(jobs, parallelForCoversTheRangeOnce) {
+    JobSystem jobs(4);
+    const unsigned int begin = 7, end = 1000;
+    for (unsigned int grainSize : {0u, 1u, 3u, 64u, 5000u}) {
+        std::vector<std::atomic<int>> visits(end);
+        std::atomic<bool> rangeInBounds{true};
+        jobs.wait(jobs.parallelFor(begin, end, grainSize, [&](unsigned int first, unsigned int last) {
+            if (first >= last || first < begin || last > end)
+                rangeInBounds = false;
+            for (unsigned int i = first; i < last; i++)
+                visits[i]++;
+        }));
+
+        EXPECT(rangeInBounds.load());
+        for (unsigned int i = 0; i < end; i++)
+            EXPECT_EQUAL(visits[i].load(), i < begin ? 0 : 1);
+    }
+
+    // an empty range is done right away
+    std::atomic<bool> called{false};
+    jobs.wait(jobs.parallelFor(5, 5, 1, [&called](unsigned int, unsigned int) { called = true; }));
+    EXPECT(!called.load());
+}
+
+TEST(jobs, waitFromWorkerRunsOtherJobs) {
+    // with a single worker, a job waiting on another can only finish if the wait runs it
+    JobSystem jobs(1);
+    std::atomic<bool> innerRan{false};
+    JobHandle outer = jobs.submit([&]() {
+        JobHandle inner = jobs.submit([&innerRan]() { innerRan = true; });
+        jobs.wait(inner);
+    });
+
+    EXPECT(waitWithoutHelping(outer));
+    EXPECT(innerRan.load());
+}
+
+TEST(jobs, nestedParallelForFromWorkers) {
+    JobSystem jobs(2);
+    std::atomic<unsigned int> sum{0};
+    jobs.wait(jobs.parallelFor(0, 8, 1, [&](unsigned int, unsigned int) {
+        jobs.wait(jobs.parallelFor(0, 100, 10, [&sum](unsigned int first, unsigned int last) {
+            sum += last - first;
+        }));
+    }));
+    EXPECT_EQUAL(sum.load(), 800u);
+}
+
+TEST(jobs, destructorDrainsQueuedJobs) {
+    std::atomic<int> ran{0};
+    std::atomic<int> continuationsRan{0};
+    {
+        JobSystem jobs(2);
+        for (int i = 0; i < 200; i++) {
+            JobHandle job = jobs.submit([&ran]() {
+                std::this_thread::sleep_for(std::chrono::microseconds(50));
+                ran++;
+            });
+            jobs.then(job, [&continuationsRan]() { continuationsRan++; });
+        }
+    }
+    EXPECT_EQUAL(ran.load(), 200);
+    EXPECT_EQUAL(continuationsRan.load(), 200);
+}
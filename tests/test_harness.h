@@ -0,0 +1,61 @@
+//
+// Created on 10/19/2026.
+//
+#pragma once
+
+#include <iostream>
+#include <vector>
+
+/** A minimal test harness: TEST registers a case in a group, EXPECT records a failure without stopping the case. The
+ * groups are run by name from the command line, see tests/test_main.cpp.
+ */
+struct TestCase {
+    const char *group;
+    const char *name;
+    void (*run)();
+};
+
+/// Every registered case, in registration order
+inline std::vector<TestCase> &getTestCases() {
+    static std::vector<TestCase> cases;
+    return cases;
+}
+
+/// Failed checks of the current run
+inline unsigned int testFailures = 0;
+
+/// Set by a case that can't run here (i.e. no OpenGL context), the run then exits with TEST_SKIPPED
+inline bool testSkipped = false;
+
+/// The exit code CTest reads as a skipped test (SKIP_RETURN_CODE)
+static constexpr int TEST_SKIPPED = 77;
+
+struct TestRegistration {
+    TestRegistration(const char *group, const char *name, void (*run)()) {
+        getTestCases().push_back({group, name, run});
+    }
+};
+
+#define TEST(group, name) \
+    static void group##_##name(); \
+    static TestRegistration group##_##name##_registration(#group, #name, group##_##name); \
+    static void group##_##name()
+
+#define EXPECT(condition) \
+    do { \
+        if (!(condition)) { \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": EXPECT(" #condition ") failed" << std::endl; \
+            testFailures++; \
+        } \
+    } while (false)
+
+#define EXPECT_EQUAL(actual, expected) \
+    do { \
+        auto actualValue = (actual); \
+        auto expectedValue = (expected); \
+        if (!(actualValue == expectedValue)) { \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": EXPECT_EQUAL(" #actual ", " #expected ") failed: " \
+                      << actualValue << " != " << expectedValue << std::endl; \
+            testFailures++; \
+        } \
+    } while (false)
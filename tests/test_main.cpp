@@ -0,0 +1,37 @@
+//
+// Created on 10/19/2026.
+//
+// Runs the test cases of one group, or of every group without arguments.
+// Usage: engine-tests [group]
+//
+#include <cstring>
+#include "../libs/easylogging++.h"
+#include "test_harness.h"
+
+INITIALIZE_EASYLOGGINGPP
+
+int main(int argc, char *argv[]) {
+    const char *group = argc > 1 ? argv[1] : nullptr;
+
+    unsigned int run = 0;
+    for (const TestCase &test : getTestCases()) {
+        if (group && std::strcmp(group, test.group) != 0)
+            continue;
+        unsigned int failuresBefore = testFailures;
+        test.run();
+        if (testSkipped) {
+            std::cout << "SKIP " << test.group << "." << test.name << std::endl;
+            return TEST_SKIPPED;
+        }
+        std::cout << (testFailures == failuresBefore ? "PASS " : "FAIL ") << test.group << "." << test.name
+                  << std::endl;
+        run++;
+    }
+
+    if (run == 0) {
+        std::cerr << "No test cases in group " << (group ? group : "(all)") << "." << std::endl;
+        return 1;
+    }
+    std::cout << run << " cases, " << testFailures << " failed checks." << std::endl;
+    return testFailures == 0 ? 0 : 1;
+}
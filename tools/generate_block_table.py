@@ -0,0 +1,102 @@
+#!/usr/bin/env python3
+#
+# Created on 10/19/2026.
+#
+# Compiles the .block files of resources/blocks into a C++ header holding a constexpr table of BlockProperties, which
+# BlockRegistry uses instead of parsing the files at run time when the game is built with COMPILED_BLOCK_REGISTRY.
+# The parsing follows BlockRegistry::parse, and the fields are written in the order of BlockProperties.
+#
+# Usage (CMake runs it when the option is on):
+#   python3 tools/generate_block_table.py --blocks resources/blocks --output build/generated/block_table.generated.h
+#
+import argparse
+import os
+import sys
+
+FACES = ["right", "left", "top", "bottom", "back", "front"]
+
+
+def parse_block(path):
+    """Returns the properties of a .block file as a dict, like BlockRegistry::parse"""
+    block = {"id": None, "name": "", "model": "", "textureType": "ABSTRACT", "texture": "", "faces": [""] * 6,
+             "placeSound": "", "opaque": True, "transparent": False, "breakable": True, "slot": 0}
+    with open(path) as file:
+        for line in file:
+            if ":" not in line:
+                continue
+            key, value = (part.strip() for part in line.split(":", 1))
+            if not key or not value:
+                continue
+            if key == "ID":
+                block["id"] = int(value)
+            elif key == "name":
+                block["name"] = value
+            elif key == "model":
+                block["model"] = "models/" + value
+            elif key == "all":
+                block["texture"] = "textures/" + value
+                block["textureType"] = "TEXTURE2D"
+            elif key == "sound":
+                block["placeSound"] = value
+            elif key in ("opaque", "transparent", "breakable"):
+                block[key] = value == "true"
+            elif key == "slot":
+                block["slot"] = int(value)
+            elif key in FACES:
+                block["faces"][FACES.index(key)] = "textures/" + value
+                block["textureType"] = "CUBEMAP"
+            else:
+                print("Unknown key \"%s\" in %s." % (key, path), file=sys.stderr)
+    return block
+
+
+def quote(text):
+    return '"%s"' % text.replace("\\", "\\\\").replace('"', '\\"')
+
+
+def boolean(value):
+    return "true" if value else "false"
+
+
+def write_table(blocks, output):
+    """Writes the header, one BlockProperties per block, sorted by ID"""
+    lines = ["// Generated by tools/generate_block_table.py from resources/blocks, do not edit.",
+             "#pragma once", "", "static constexpr BlockProperties COMPILED_BLOCKS[] = {"]
+    for block in blocks:
+        faces = ", ".join(quote(face) for face in block["faces"])
+        lines.append("        {static_cast<BlockID>(%d), true, %s, %s, %s, %s, {{%s}}, %s, %s, %s, %s, %du}," % (
+            block["id"], quote(block["name"]), quote(block["model"]), block["textureType"], quote(block["texture"]),
+            faces, quote(block["placeSound"]), boolean(block["opaque"]), boolean(block["transparent"]),
+            boolean(block["breakable"]), block["slot"]))
+    lines.append("};")
+    content = "\n".join(lines) + "\n"
+
+    os.makedirs(os.path.dirname(os.path.abspath(output)), exist_ok=True)
+    with open(output, "w") as file:
+        file.write(content)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compiles the .block files into a constexpr C++ table.")
+    parser.add_argument("--blocks", default="resources/blocks", help="the folder of .block files")
+    parser.add_argument("--output", required=True, help="the header to write")
+    args = parser.parse_args()
+
+    blocks = []
+    for name in sorted(os.listdir(args.blocks)):
+        if not name.endswith(".block"):
+            continue
+        block = parse_block(os.path.join(args.blocks, name))
+        if block["id"] is None:
+            print("%s has no block ID, skipping it." % name, file=sys.stderr)
+            continue
+        blocks.append(block)
+    blocks.sort(key=lambda block: block["id"])
+
+    write_table(blocks, args.output)
+    print("Compiled %d blocks into %s." % (len(blocks), args.output))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
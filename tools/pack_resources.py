@@ -0,0 +1,83 @@
+#!/usr/bin/env python3
+#
+# Created on 10/19/2026.
+#
+# Bundles every file under resources/ into a single indexed archive, resources.pack, which the game memory-maps at
+# startup instead of opening the loose files (see include/resource_pack.h for the layout). Without the archive, the
+# game reads the loose resources/ folder.
+#
+# Usage (from the build folder, next to resources/):
+#   python3 ../tools/pack_resources.py                                  # resources/ -> resources.pack
+#   python3 ../tools/pack_resources.py --resources DIR --output FILE
+#
+import argparse
+import os
+import struct
+import sys
+
+MAGIC = b"RPAK"
+VERSION = 1
+HEADER = struct.Struct("<4sII4x")   # magic, version, entry count
+ENTRY = struct.Struct("<QQII")      # data offset, data size, path offset, path length
+DATA_ALIGNMENT = 16
+
+
+def collect(resources):
+    """Returns the paths of the files under the resources folder, relative to it with '/' separators, sorted"""
+    paths = []
+    for folder, _, files in os.walk(resources):
+        for name in files:
+            relative = os.path.relpath(os.path.join(folder, name), resources)
+            paths.append(relative.replace(os.sep, "/"))
+    return sorted(paths)
+
+
+def align(offset):
+    return (offset + DATA_ALIGNMENT - 1) // DATA_ALIGNMENT * DATA_ALIGNMENT
+
+
+def write_pack(resources, paths, output):
+    """Writes the header, the entries, the path strings and then every file, each aligned to DATA_ALIGNMENT"""
+    names = [path.encode("utf-8") for path in paths]
+    strings_start = HEADER.size + ENTRY.size * len(paths)
+    data_offset = align(strings_start + sum(len(name) for name in names))
+
+    entries = []
+    string_offset = strings_start
+    for path, name in zip(paths, names):
+        size = os.path.getsize(os.path.join(resources, path))
+        entries.append(ENTRY.pack(data_offset, size, string_offset, len(name)))
+        string_offset += len(name)
+        data_offset = align(data_offset + size)
+
+    temporary = output + ".tmp"
+    with open(temporary, "wb") as pack:
+        pack.write(HEADER.pack(MAGIC, VERSION, len(paths)))
+        for entry in entries:
+            pack.write(entry)
+        for name in names:
+            pack.write(name)
+        for path in paths:
+            pack.write(b"\0" * (align(pack.tell()) - pack.tell()))
+            with open(os.path.join(resources, path), "rb") as file:
+                pack.write(file.read())
+    os.replace(temporary, output)
+    return data_offset
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Bundles the resources folder into one memory-mappable archive.")
+    parser.add_argument("--resources", default="resources", help="the folder to pack (default resources)")
+    parser.add_argument("--output", default="resources.pack", help="the archive to write (default resources.pack)")
+    args = parser.parse_args()
+
+    if not os.path.isdir(args.resources):
+        sys.exit("No %s folder to pack." % args.resources)
+    paths = collect(args.resources)
+    size = write_pack(args.resources, paths, args.output)
+    print("Packed %d files into %s (%d KiB)." % (len(paths), args.output, size // 1024))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,102 @@
+#!/usr/bin/env python3
+#
+# Created on 10/19/2026.
+#
+# Runs the headless startup of the game several times and compares the median time of each startup stage, and the
+# time to the first frame, against a stored baseline. Exits with 1 if a stage got slower than the tolerance allows.
+#
+# Usage (from the build folder, next to resources/):
+#   python3 ../tools/startup_regression.py --binary ./COMP-371-Project --update-baseline   # record the baseline
+#   python3 ../tools/startup_regression.py --binary ./COMP-371-Project                     # compare against it
+#
+import argparse
+import json
+import os
+import statistics
+import subprocess
+import sys
+import tempfile
+
+FIRST_FRAME = "timeToFirstFrameMs"
+
+
+def run_startup(binary, seed, world_size, report_dir, index):
+    """Runs one headless startup (a single frame) and returns its startup report"""
+    startup_report = os.path.join(report_dir, "startup_%d.json" % index)
+    command = [binary, "--headless", "--frames", "1", "--seed", str(seed), "--world-size", world_size,
+               "--startup-report", startup_report, "--report", os.path.join(report_dir, "headless_%d.json" % index)]
+    result = subprocess.run(command, stdout=subprocess.DEVNULL, stderr=subprocess.PIPE, universal_newlines=True)
+    if result.returncode != 0:
+        sys.exit("Run %d failed with exit code %d:\n%s" % (index, result.returncode, result.stderr))
+    with open(startup_report) as file:
+        return json.load(file)
+
+
+def median_timings(reports):
+    """Returns the median duration of every stage over the runs, and the median time to the first frame"""
+    durations = {}
+    for report in reports:
+        for stage in report["stages"]:
+            durations.setdefault(stage["name"], []).append(stage["durationMs"])
+        durations.setdefault(FIRST_FRAME, []).append(report[FIRST_FRAME])
+    return {name: statistics.median(values) for name, values in durations.items()}
+
+
+def compare(medians, baseline, tolerance, noise_ms):
+    """Prints each timing next to its baseline and returns the names of the ones that regressed"""
+    regressions = []
+    print("%-20s %12s %12s %9s" % ("stage", "baseline ms", "median ms", "change"))
+    for name, median in medians.items():
+        if name not in baseline:
+            print("%-20s %12s %12.1f %9s" % (name, "-", median, "new"))
+            continue
+        reference = baseline[name]
+        change = (median - reference) / reference if reference > 0 else 0.0
+        # short stages are noisy, so a regression also has to be worth a few milliseconds
+        regressed = median > reference * (1.0 + tolerance) and median - reference > noise_ms
+        print("%-20s %12.1f %12.1f %+8.1f%%%s" % (name, reference, median, change * 100.0,
+                                                   "  SLOWER" if regressed else ""))
+        if regressed:
+            regressions.append(name)
+    return regressions
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Flags startup time regressions against a stored baseline.")
+    parser.add_argument("--binary", required=True, help="the game's executable")
+    parser.add_argument("--runs", type=int, default=5, help="number of startups to take the median of (default 5)")
+    parser.add_argument("--baseline", default="startup_baseline.json", help="the stored baseline")
+    parser.add_argument("--update-baseline", action="store_true", help="store the medians as the new baseline")
+    parser.add_argument("--tolerance", type=float, default=0.15,
+                        help="how much slower than the baseline a timing may get, as a fraction (default 0.15)")
+    parser.add_argument("--noise-ms", type=float, default=5.0,
+                        help="differences below this many milliseconds are never flagged (default 5)")
+    parser.add_argument("--seed", type=int, default=1234, help="world seed, fixed so every run does the same work")
+    parser.add_argument("--world-size", default="s", choices=["s", "m", "l"], help="world size (default s)")
+    args = parser.parse_args()
+
+    with tempfile.TemporaryDirectory() as report_dir:
+        reports = [run_startup(args.binary, args.seed, args.world_size, report_dir, i) for i in range(args.runs)]
+    medians = median_timings(reports)
+
+    if args.update_baseline:
+        with open(args.baseline, "w") as file:
+            json.dump(medians, file, indent=2, sort_keys=True)
+        print("Stored the medians of %d runs in %s." % (args.runs, args.baseline))
+        return 0
+
+    if not os.path.exists(args.baseline):
+        sys.exit("No baseline at %s, record one with --update-baseline." % args.baseline)
+    with open(args.baseline) as file:
+        baseline = json.load(file)
+
+    regressions = compare(medians, baseline, args.tolerance, args.noise_ms)
+    if regressions:
+        print("Startup got slower: %s." % ", ".join(regressions))
+        return 1
+    print("No startup regressions over %d runs." % args.runs)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())